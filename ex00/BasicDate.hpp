@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <ex00/Date.hpp>
+#include <ex00/calendar_system/DateFormat.hpp>
+
+namespace toolbox {
+
+/**
+ * @brief A Date bound to one calendar system at compile time.
+ *
+ * Date picks its calendar with a runtime switch on CalendarSystem and
+ * converts through the ICalendarSystem interface, i.e. a switch and a
+ * virtual call per conversion. BasicDate<Calendar> names the calendar class
+ * instead (BasicDate<GregorianCalendar>, BasicDate<JulianCalendar>, ...) and
+ * calls its conversions directly, with qualified (non-virtual) calls on a
+ * single shared instance.
+ *
+ * The representation is the same serial date as Date's, so the two convert
+ * into each other for free; code that only learns the calendar at run time
+ * keeps using Date.
+ *
+ * @tparam Calendar An ICalendarSystem implementation with a default
+ *         constructor.
+ */
+template<typename Calendar>
+class BasicDate {
+ public:
+    BasicDate() : _serial_date(0) {}
+
+    BasicDate(const BasicDate& other) : _serial_date(other._serial_date) {}
+
+    BasicDate& operator=(const BasicDate& other) {
+        if (this != &other) {
+            _serial_date = other._serial_date;
+        }
+        return *this;
+    }
+
+    ~BasicDate() {}
+
+    explicit BasicDate(int serial_date) : _serial_date(serial_date) {}
+
+    explicit BasicDate(const Date& date) : _serial_date(date.get_raw_date()) {}
+
+    BasicDate(int era, int year, int month, int day)
+        : _serial_date(calendar().Calendar::to_serial_date(
+            era, year, month, day)) {}
+
+    explicit BasicDate(const std::string& date_str,
+            const char* format = "%y-%m-%d", bool strict = true)
+        : _serial_date(0) {
+        if (!format) {
+            throw std::invalid_argument("BasicDate::BasicDate failed: "
+                "format is null");
+        }
+        _serial_date = calendar().Calendar::to_serial_date(
+            date_str, format, strict);
+    }
+
+    BasicDate(const std::string& date_str, const DateFormat& format,
+            bool strict = true)
+        : _serial_date(calendar().Calendar::to_serial_date(
+            date_str, format, strict)) {}
+
+    // Non-throwing counterparts of the parsing constructors (see Date::parse).
+    ParseResult parse(const std::string& date_str,
+            const char* format = "%y-%m-%d", bool strict = true) {
+        if (!format) {
+            throw std::invalid_argument("BasicDate::parse failed: "
+                "format is null");
+        }
+        return calendar().Calendar::parse_serial_date(
+            date_str, format, strict, _serial_date);
+    }
+
+    ParseResult parse(const std::string& date_str, const DateFormat& format,
+            bool strict = true) {
+        return calendar().Calendar::parse_serial_date(
+            date_str, format, strict, _serial_date);
+    }
+
+    std::string to_string(const char* format = "%Y-%M-%D") const {
+        if (!format) {
+            throw std::invalid_argument("BasicDate::to_string failed: "
+                "format is null");
+        }
+        std::string date_str;
+        calendar().Calendar::from_serial_date(_serial_date, date_str, format);
+        return date_str;
+    }
+
+    std::string to_string(const DateFormat& format) const {
+        std::string date_str;
+        calendar().Calendar::from_serial_date(_serial_date, date_str, format);
+        return date_str;
+    }
+
+    // Allocation-free form (see Date::to_string).
+    std::size_t to_string(char* buffer, std::size_t size,
+            const DateFormat& format) const {
+        return calendar().Calendar::from_serial_date(
+            _serial_date, buffer, size, format);
+    }
+
+    Date to_date() const {
+        return Date(_serial_date);
+    }
+
+    int get_raw_date() const {
+        return _serial_date;
+    }
+
+    // All the fields from one conversion (see Date::get_civil_date).
+    CivilDate get_civil_date() const {
+        CivilDate civil;
+        calendar().Calendar::from_serial_date(_serial_date,
+            civil.era, civil.year, civil.month, civil.day);
+        calendar().Calendar::from_serial_date(_serial_date, civil.weekday);
+        return civil;
+    }
+
+    int get_day() const {
+        int era, year, month, day;
+        calendar().Calendar::from_serial_date(
+            _serial_date, era, year, month, day);
+        return day;
+    }
+
+    int get_month() const {
+        int era, year, month, day;
+        calendar().Calendar::from_serial_date(
+            _serial_date, era, year, month, day);
+        return month;
+    }
+
+    int get_year() const {
+        int era, year, month, day;
+        calendar().Calendar::from_serial_date(
+            _serial_date, era, year, month, day);
+        return year;
+    }
+
+    int get_weekday() const {  // 0=Sun, 1=Mon, ..., 6=Sat
+        int day_of_week;
+        calendar().Calendar::from_serial_date(_serial_date, day_of_week);
+        return day_of_week;
+    }
+
+    BasicDate& operator++() {
+        ++_serial_date;
+        return *this;
+    }
+
+    BasicDate operator++(int) {
+        BasicDate old(*this);
+        ++_serial_date;
+        return old;
+    }
+
+    BasicDate& operator--() {
+        --_serial_date;
+        return *this;
+    }
+
+    BasicDate operator--(int) {
+        BasicDate old(*this);
+        --_serial_date;
+        return old;
+    }
+
+    BasicDate operator+(const int delta) const {
+        return BasicDate(_serial_date + delta);
+    }
+
+    BasicDate operator-(const int delta) const {
+        return BasicDate(_serial_date - delta);
+    }
+
+    int operator-(const BasicDate& other) const {
+        return _serial_date - other._serial_date;
+    }
+
+    BasicDate& operator+=(const int delta) {
+        _serial_date += delta;
+        return *this;
+    }
+
+    BasicDate& operator-=(const int delta) {
+        _serial_date -= delta;
+        return *this;
+    }
+
+    bool operator==(const BasicDate& other) const {
+        return _serial_date == other._serial_date;
+    }
+
+    bool operator!=(const BasicDate& other) const {
+        return _serial_date != other._serial_date;
+    }
+
+    bool operator<(const BasicDate& other) const {
+        return _serial_date < other._serial_date;
+    }
+
+    bool operator<=(const BasicDate& other) const {
+        return _serial_date <= other._serial_date;
+    }
+
+    bool operator>(const BasicDate& other) const {
+        return _serial_date > other._serial_date;
+    }
+
+    bool operator>=(const BasicDate& other) const {
+        return _serial_date >= other._serial_date;
+    }
+
+ private:
+    // The calendars are stateless; one instance serves every BasicDate.
+    static const Calendar& calendar() {
+        static const Calendar instance;
+        return instance;
+    }
+
+    int _serial_date;  // same epoch as Date (0 is 1970-01-01)
+};
+
+}  // namespace toolbox
@@ -1,5 +1,7 @@
 #include <ex00/BitcoinExchange.hpp>
 
+#include <sched.h>
+
 #include <iostream>
 #include <string>
 #include <cstring>
@@ -9,19 +11,53 @@
 #include <stdexcept>
 #include <map>
 #include <utility>
+#include <vector>
+#include <algorithm>
 
 #include <ex00/Date.hpp>
-#include <toolbox/string.hpp>
+#include <ex00/RateIndex.hpp>
+#include <ex00/DenseRateTable.hpp>
+#include <ex00/CompressedRates.hpp>
+#include <ex00/RateAggregates.hpp>
+#include <ex00/RateStream.hpp>
 #include <toolbox/StepMark.hpp>
+#include <toolbox/MappedFile.hpp>
+#include <toolbox/hash.hpp>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+#endif
 
-BitcoinExchange::BitcoinExchange() : _exchange_rates() {}
+namespace {
+void parse_rows(const char *cursor, const char *end,
+    const char *report_from, RateIndexBuilder &builder);
+bool stat_identity(const std::string &filename, uint64_t &device,
+    uint64_t &inode);
+}  // namespace
+
+BitcoinExchange::BitcoinExchange()
+    : _exchange_rates(), _dense_rates(), _compressed_rates(), _aggregates(),
+    _aggregates_state(AGGREGATES_STALE), _lookup_mode(BINARY_SEARCH),
+    _source() {}
 
 BitcoinExchange::BitcoinExchange(const BitcoinExchange &other)
-    : _exchange_rates(other._exchange_rates) {}
+    : _exchange_rates(other._exchange_rates),
+    _dense_rates(other._dense_rates),
+    _compressed_rates(other._compressed_rates),
+    _aggregates(),
+    _aggregates_state(AGGREGATES_STALE),
+    _lookup_mode(other._lookup_mode),
+    _source(other._source) {}
 
 BitcoinExchange &BitcoinExchange::operator=(const BitcoinExchange &other) {
     if (this != &other) {
         _exchange_rates = other._exchange_rates;
+        _dense_rates = other._dense_rates;
+        _compressed_rates = other._compressed_rates;
+        _aggregates.clear();
+        _aggregates_state = AGGREGATES_STALE;
+        _lookup_mode = other._lookup_mode;
+        _source = other._source;
     }
     return *this;
 }
@@ -29,106 +65,492 @@ BitcoinExchange &BitcoinExchange::operator=(const BitcoinExchange &other) {
 BitcoinExchange::~BitcoinExchange() {}
 
 BitcoinExchange::BitcoinExchange(const std::string &data_filename)
-    : _exchange_rates() {
+    : _exchange_rates(), _dense_rates(), _compressed_rates(), _aggregates(),
+    _aggregates_state(AGGREGATES_STALE), _lookup_mode(BINARY_SEARCH),
+    _source() {
     load_data(data_filename);
 }
 
-void BitcoinExchange::load_data(const std::string &data_filename) {
+/*
+ * @brief Replaces the rate history with the rows of data_filename.
+ * @param reported_size Leading bytes of the file whose rows (and header)
+ *        have already been checked and reported, by a RateStream: their
+ *        warnings are not repeated.
+ */
+void BitcoinExchange::load_data(const std::string &data_filename,
+        std::size_t reported_size) {
     toolbox::logger::StepMark::info(std::string(
         "Loading exchange rate data from file: ") + data_filename);
-    std::ifstream file(data_filename.c_str());
-    if (!file.is_open()) {
+    toolbox::MappedFile file;
+    if (!file.open(data_filename)) {
         std::cerr << "Warning: failed to open data file: " << data_filename
             << " (the database will be empty)" << std::endl;
         toolbox::logger::StepMark::warning(std::string(
             "Failed to open data file: ") + data_filename);
         return;
     }
-    std::string line;
-    if (!std::getline(file, line)) {
+    const char *cursor = file.data();
+    const char *const end = cursor + file.size();
+    const char *line_begin;
+    const char *line_end;
+    if (!toolbox::next_line(cursor, end, line_begin, line_end)) {
         std::cerr << "Warning: data file is empty: " << data_filename
             << " (the database will be empty)" << std::endl;
         toolbox::logger::StepMark::warning(std::string(
             "Data file is empty: ") + data_filename);
         return;
     }
-    if (line != "date,exchange_rate") {
+    const char header[] = "date,exchange_rate";
+    if (reported_size == 0 && (static_cast<std::size_t>(line_end - line_begin)
+            != sizeof(header) - 1
+        || std::memcmp(line_begin, header, sizeof(header) - 1) != 0)) {
         std::cerr << "Warning: invalid header in data file: " << data_filename
             << "(Expecting 'date,exchange_rate')" << std::endl;
         toolbox::logger::StepMark::warning(std::string(
             "Invalid header detected in data file: ") + data_filename);
     }
-    std::map<toolbox::Date, double> new_map;
-    while (std::getline(file, line)) {
-        std::size_t pos_delimiter = line.find(",");
-        if (pos_delimiter == std::string::npos) {
-            std::cerr << "Warning: invalid line format "
-                << "(missing delimiter) in data file: "
-                << line << "(this line will be ignored)" << std::endl;
-            toolbox::logger::StepMark::warning(std::string(
-                "Ignoring malformed line (missing delimiter): ") + line);
-            continue;
-        }
-        std::string date_str = line.substr(0, pos_delimiter);
-        std::string value_str = line.substr(pos_delimiter + 1);
-        if (date_str.empty() || value_str.empty()) {
-            std::cerr << "Warning: invalid line format "
-                << "(empty date or value) in data file: "
-                << line << "(this line will be ignored)" << std::endl;
-            toolbox::logger::StepMark::warning(std::string(
-                "Ignoring malformed line (empty date or value): ") + line);
-            continue;
-        }
-        toolbox::Date date;
-        double value;
-        try {
-            date = toolbox::Date(toolbox::GREGORIAN, date_str,
-                "%Y-%m-%d", true);
-            value = toolbox::stod(value_str);
-        } catch (const std::exception &e) {
-            std::cerr << "Warning: invalid data in line: " << line
-                << " (" << e.what() << ") (this line will be ignored)"
-                << std::endl;
-            std::ostringstream oss;
-            oss << "Ignoring invalid data line: " << line
-                << " (" << e.what() << ")";
-            toolbox::logger::StepMark::warning(oss.str());
-            continue;
-        }
-        if (value < 0.0) {
-            std::cerr << "Warning: negative exchange rate in line: "
-                << line << " (this line will be ignored)" << std::endl;
-            toolbox::logger::StepMark::warning(std::string(
-                "Ignoring negative exchange rate: ") + line);
-            continue;
-        }
-        if (new_map.count(date) > 0) {
-            std::cerr << "Warning: duplicate date entry in data file: "
-                << line << " (the rate for this date will be overwritten)"
-                << std::endl;
-            toolbox::logger::StepMark::notice(std::string(
-                "Duplicate date detected, overwriting entry: ") + line);
-        }
-        new_map[date] = value;
-    }
-    std::swap(_exchange_rates, new_map);
+    RateIndexBuilder builder;
+    parse_rows(cursor, end,
+        file.data() + std::min(reported_size, file.size()), builder);
+    RateIndex new_index;
+    builder.build(new_index);
+    _exchange_rates.swap(new_index);
+    index_changed();
+    remember_source(data_filename, file.data(), file.size());
     std::ostringstream oss;
     oss << "Exchange rate data loaded. Total entries: "
         << _exchange_rates.size();
     toolbox::logger::StepMark::info(oss.str());
 }
 
+/*
+ * @brief Brings the rate history up to date with data_filename.
+ * @note If data_filename is the file last loaded and it has only grown
+ *       since (same file, the ingested bytes unchanged, the last ingested
+ *       line was complete), only the appended rows are parsed and merged
+ *       into a copy of the index. Anything else (another file, truncation,
+ *       replacement, an edit in place, an unterminated last line that may
+ *       have been extended) falls back to a full load_data.
+ * @note The current history stays in use until the new index is complete;
+ *       it is then swapped in as a whole.
+ * @note [complexity]: O(k) parsing for k appended bytes, plus O(m) hashing
+ *       of the m bytes ingested before (far cheaper than parsing them) and
+ *       O(n) to copy the n existing entries.
+ */
+void BitcoinExchange::reload_data(const std::string &data_filename) {
+    toolbox::logger::StepMark::info(std::string(
+        "Reloading exchange rate data from file: ") + data_filename);
+    const char *reason = NULL;
+    toolbox::MappedFile file;
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    if (_source.filename.empty() || _source.filename != data_filename) {
+        reason = "not the file previously loaded";
+    } else if (!file.open(data_filename)
+        || !stat_identity(data_filename, device, inode)) {
+        reason = "cannot open the data file";
+    } else if (device != _source.device || inode != _source.inode) {
+        reason = "the data file was replaced";
+    } else if (file.size() < _source.size) {
+        reason = "the data file was truncated";
+    } else if (toolbox::hash::fnv1a(file.data(), _source.size)
+            != _source.checksum) {
+        reason = "the data file was rewritten";
+    } else if (file.size() > _source.size
+        && _source.complete_size != _source.size
+        && file.data()[_source.size] != '\n') {
+        reason = "the last line was extended";
+    }
+    if (reason != NULL) {
+        toolbox::logger::StepMark::notice(std::string(
+            "Full reload of exchange rate data (") + reason + ")");
+        file.close();
+        load_data(data_filename);
+        return;
+    }
+    const char *cursor = file.data() + _source.size;
+    const char *const end = file.data() + file.size();
+    if (cursor != end && _source.complete_size != _source.size) {
+        ++cursor;  // the '\n' that terminates the last ingested line
+    }
+    std::size_t new_entries = 0;
+    if (cursor != end) {
+        RateIndexBuilder builder;
+        builder.assign(_exchange_rates);
+        parse_rows(cursor, end, cursor, builder);
+        new_entries = builder.size() - _exchange_rates.size();
+        RateIndex new_index;
+        builder.build(new_index);
+        _exchange_rates.swap(new_index);
+        index_changed();
+    }
+    remember_source(data_filename, file.data(), file.size());
+    std::ostringstream oss;
+    oss << "Exchange rate data reloaded incrementally. Bytes parsed: "
+        << (end - cursor) << ", new entries: " << new_entries
+        << ", total entries: " << _exchange_rates.size();
+    toolbox::logger::StepMark::info(oss.str());
+}
+
+/*
+ * @brief Saves the loaded rate history as a binary snapshot, which
+ *        load_snapshot can restore without parsing data.csv again.
+ * @throw std::runtime_error if the snapshot cannot be written.
+ */
+void BitcoinExchange::save_snapshot(
+        const std::string &snapshot_filename) const {
+    _exchange_rates.write_snapshot(snapshot_filename);
+    std::ostringstream oss;
+    oss << "Exchange rate snapshot saved to " << snapshot_filename
+        << ". Total entries: " << _exchange_rates.size();
+    toolbox::logger::StepMark::info(oss.str());
+}
+
+/*
+ * @brief Replaces the rate history with a snapshot made by save_snapshot.
+ * @return false (with a warning in the log) if the snapshot is missing,
+ *         stale in format or corrupted; the loaded data is then unchanged
+ *         and the caller is expected to fall back to load_data.
+ */
+bool BitcoinExchange::load_snapshot(const std::string &snapshot_filename) {
+    toolbox::logger::StepMark::info(std::string(
+        "Loading exchange rate snapshot from file: ") + snapshot_filename);
+    try {
+        _exchange_rates.read_snapshot(snapshot_filename);
+    } catch (const std::exception &e) {
+        toolbox::logger::StepMark::warning(std::string(
+            "Failed to load exchange rate snapshot: ") + e.what());
+        return false;
+    }
+    index_changed();
+    forget_source();
+    std::ostringstream oss;
+    oss << "Exchange rate snapshot loaded. Total entries: "
+        << _exchange_rates.size();
+    toolbox::logger::StepMark::info(oss.str());
+    return true;
+}
+
 double BitcoinExchange::get_exchange_rate(const toolbox::Date &date) const {
-    std::map<toolbox::Date, double>::const_iterator it;
-    it = _exchange_rates.upper_bound(date);
-    if (it == _exchange_rates.begin()) {
+    double rate;
+    if (!find_exchange_rate(date, rate)) {
         throw std::out_of_range(
             "No exchange rate data available for the given date or earlier");
     }
-    --it;
-    return it->second;
+    return rate;
+}
+
+/*
+ * @brief Looks up the rate in effect on date, as get_exchange_rate does,
+ *        without throwing.
+ * @return false if no rate is in effect on date (rate is then unchanged).
+ */
+bool BitcoinExchange::find_exchange_rate(const toolbox::Date &date,
+        double &rate) const {
+    if (!_dense_rates.empty()) {
+        return _dense_rates.find(date.get_raw_date(), rate);
+    }
+    if (!_compressed_rates.empty()) {
+        return _compressed_rates.find(date.get_raw_date(), rate);
+    }
+    return _exchange_rates.find(date.get_raw_date(), rate);
+}
+
+/*
+ * @brief Converts every query in one pass (an as-of join against the history).
+ * @return One result per query, in the order of queries.
+ * @note Queries are visited in date order (sorted first unless they already
+ *       are), so the rate index is walked once from left to right instead of
+ *       being searched from scratch for each query.
+ * @note [complexity]: O(n log(m / n)) for n sorted queries against m
+ *       entries, plus O(n log n) if the queries have to be sorted.
+ */
+std::vector<BitcoinExchange::ConversionResult> BitcoinExchange::convert(
+        const std::vector<ConversionQuery> &queries) const {
+    const std::size_t n = queries.size();
+    std::vector<ConversionResult> results(n);
+    if (!_dense_rates.empty()) {
+        for (std::size_t i = 0; i < n; ++i) {
+            ConversionResult &res = results[i];
+            res.found = _dense_rates.find(queries[i].date.get_raw_date(),
+                res.rate);
+            res.value = res.found ? queries[i].amount * res.rate : 0.0;
+            if (!res.found) {
+                res.rate = 0.0;
+            }
+        }
+        return results;
+    }
+    std::vector<std::pair<int, std::size_t> > order;
+    bool sorted = true;
+    for (std::size_t i = 1; i < n && sorted; ++i) {
+        sorted = !(queries[i].date < queries[i - 1].date);
+    }
+    if (!sorted) {
+        order.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            order.push_back(std::make_pair(
+                queries[i].date.get_raw_date(), i));
+        }
+        std::sort(order.begin(), order.end());
+    }
+    const double *rates = _exchange_rates.rates();
+    std::size_t pos = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t i = sorted ? k : order[k].second;
+        pos = _exchange_rates.upper_bound_from(pos,
+            queries[i].date.get_raw_date());
+        ConversionResult &res = results[i];
+        res.found = (pos > 0);
+        res.rate = res.found ? rates[pos - 1] : 0.0;
+        res.value = res.found ? queries[i].amount * res.rate : 0.0;
+    }
+    return results;
 }
 
 bool BitcoinExchange::empty() const {
     return _exchange_rates.empty();
 }
+
+void BitcoinExchange::set_lookup_mode(LookupMode mode) {
+    _lookup_mode = mode;
+    rebuild_dense_table();
+    rebuild_compressed_rates();
+}
+
+BitcoinExchange::LookupMode BitcoinExchange::get_lookup_mode() const {
+    return _lookup_mode;
+}
+
+/*
+ * @brief Sum of the rates recorded on dates in [from, to] (0 if none).
+ * @throw std::invalid_argument if from > to.
+ * @note [complexity]: O(log n), plus O(n) for the first range query after
+ *       a load
+ */
+double BitcoinExchange::get_rate_sum(const toolbox::Date &from,
+        const toolbox::Date &to) const {
+    std::size_t first;
+    std::size_t last;
+    entry_range(from, to, first, last);
+    return aggregates().sum(first, last);
+}
+
+/*
+ * @brief Smallest rate recorded on a date in [from, to].
+ * @throw std::invalid_argument if from > to.
+ * @throw std::out_of_range if no rate is recorded in [from, to].
+ * @note [complexity]: O(log n), plus O(n) for the first range query after
+ *       a load
+ */
+double BitcoinExchange::get_min_rate(const toolbox::Date &from,
+        const toolbox::Date &to) const {
+    std::size_t first;
+    std::size_t last;
+    entry_range(from, to, first, last);
+    if (first == last) {
+        throw std::out_of_range("No exchange rate data in the given range");
+    }
+    return aggregates().min(first, last);
+}
+
+/*
+ * @brief Largest rate recorded on a date in [from, to].
+ * @throw std::invalid_argument if from > to.
+ * @throw std::out_of_range if no rate is recorded in [from, to].
+ * @note [complexity]: O(log n), plus O(n) for the first range query after
+ *       a load
+ */
+double BitcoinExchange::get_max_rate(const toolbox::Date &from,
+        const toolbox::Date &to) const {
+    std::size_t first;
+    std::size_t last;
+    entry_range(from, to, first, last);
+    if (first == last) {
+        throw std::out_of_range("No exchange rate data in the given range");
+    }
+    return aggregates().max(first, last);
+}
+
+/*
+ * @brief Mean of the rates recorded on dates in [from, to] (each recorded
+ *        entry weighs the same, whatever the gap to the next one).
+ * @throw std::invalid_argument if from > to.
+ * @throw std::out_of_range if no rate is recorded in [from, to].
+ * @note [complexity]: O(log n), plus O(n) for the first range query after
+ *       a load
+ */
+double BitcoinExchange::get_mean_rate(const toolbox::Date &from,
+        const toolbox::Date &to) const {
+    std::size_t first;
+    std::size_t last;
+    entry_range(from, to, first, last);
+    if (first == last) {
+        throw std::out_of_range("No exchange rate data in the given range");
+    }
+    return aggregates().sum(first, last)
+        / static_cast<double>(last - first);
+}
+
+// Rebuilds every structure derived from _exchange_rates; the aggregates
+// are only dropped, to be built again if a range is queried.
+void BitcoinExchange::index_changed() {
+    rebuild_dense_table();
+    rebuild_compressed_rates();
+    _aggregates.clear();
+    _aggregates_state = AGGREGATES_STALE;
+}
+
+/*
+ * @brief The aggregates of _exchange_rates, built on the first call after a
+ *        load, so that loads which are never queried by range do not pay
+ *        for them.
+ * @note Several threads may query a const exchange at once: the first one
+ *       builds, the others wait for it to finish.
+ */
+const RateAggregates &BitcoinExchange::aggregates() const {
+    int state = __atomic_load_n(&_aggregates_state, __ATOMIC_ACQUIRE);
+    while (state != AGGREGATES_BUILT) {
+        int expected = AGGREGATES_STALE;
+        if (state == AGGREGATES_STALE
+            && __atomic_compare_exchange_n(&_aggregates_state, &expected,
+                static_cast<int>(AGGREGATES_BUILDING), false,
+                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            try {
+                _aggregates.build(_exchange_rates);
+            } catch (...) {
+                __atomic_store_n(&_aggregates_state,
+                    static_cast<int>(AGGREGATES_STALE), __ATOMIC_RELEASE);
+                throw;
+            }
+            __atomic_store_n(&_aggregates_state,
+                static_cast<int>(AGGREGATES_BUILT), __ATOMIC_RELEASE);
+            break;
+        }
+        ::sched_yield();
+        state = __atomic_load_n(&_aggregates_state, __ATOMIC_ACQUIRE);
+    }
+    return _aggregates;
+}
+
+// Positions [first, last) of the entries dated in [from, to].
+void BitcoinExchange::entry_range(const toolbox::Date &from,
+        const toolbox::Date &to, std::size_t &first,
+        std::size_t &last) const {
+    if (to < from) {
+        throw std::invalid_argument("Invalid date range: from > to");
+    }
+    first = _exchange_rates.upper_bound(from.get_raw_date() - 1);
+    last = _exchange_rates.upper_bound(to.get_raw_date());
+}
+
+void BitcoinExchange::rebuild_dense_table() {
+    if (_lookup_mode != DENSE_TABLE) {
+        _dense_rates.clear();
+        return;
+    }
+    if (!_dense_rates.build(_exchange_rates,
+            DenseRateTable::DEFAULT_MAX_SPAN) && !_exchange_rates.empty()) {
+        toolbox::logger::StepMark::notice(
+            "Exchange rate history is too sparse for a dense table, "
+            "using binary search lookups");
+        return;
+    }
+    if (!_dense_rates.empty()) {
+        std::ostringstream oss;
+        oss << "Dense rate table built. Days covered: "
+            << _dense_rates.span();
+        toolbox::logger::StepMark::info(oss.str());
+    }
+}
+
+/*
+ * @note The sorted arrays are kept (aggregates, batch conversion and
+ *       snapshots read them); single-date lookups only touch the compressed
+ *       copy, whose working set is a block index and one block.
+ */
+void BitcoinExchange::rebuild_compressed_rates() {
+    if (_lookup_mode != COMPRESSED) {
+        _compressed_rates.clear();
+        return;
+    }
+    _compressed_rates.build(_exchange_rates);
+    if (!_compressed_rates.empty()) {
+        std::ostringstream oss;
+        oss << "Compressed rate table built. Entries: "
+            << _compressed_rates.size() << ", bytes: "
+            << _compressed_rates.memory_size();
+        toolbox::logger::StepMark::info(oss.str());
+    }
+}
+
+// Records what has just been ingested from data_filename.
+void BitcoinExchange::remember_source(const std::string &data_filename,
+        const char *data, std::size_t size) {
+    if (!stat_identity(data_filename, _source.device, _source.inode)) {
+        forget_source();
+        return;
+    }
+    _source.filename = data_filename;
+    _source.size = size;
+    _source.complete_size = size;
+    while (_source.complete_size > 0
+        && data[_source.complete_size - 1] != '\n') {
+        --_source.complete_size;
+    }
+    _source.checksum = toolbox::hash::fnv1a(data, size);
+}
+
+void BitcoinExchange::forget_source() {
+    _source.filename.clear();
+    _source.device = 0;
+    _source.inode = 0;
+    _source.size = 0;
+    _source.complete_size = 0;
+    _source.checksum = 0;
+}
+
+namespace {
+/*
+ * @brief Parses the data rows in [cursor, end) into builder, warning about
+ *        (and skipping) every malformed row.
+ * @param report_from Rows starting before it are parsed without warnings
+ *        (they have already been reported).
+ */
+void parse_rows(const char *cursor, const char *end,
+        const char *report_from, RateIndexBuilder &builder) {
+    const char *line_begin;
+    const char *line_end;
+    while (toolbox::next_line(cursor, end, line_begin, line_end)) {
+        const bool report = (line_begin >= report_from);
+        int serial_date;
+        double rate;
+        if (!parse_rate_row(line_begin, line_end, serial_date, rate,
+                report)) {
+            continue;
+        }
+        if (builder.insert(serial_date, rate) && report) {
+            report_duplicate_rate(line_begin, line_end);
+        }
+    }
+}
+
+// Identifies the file itself, so that a replaced file is not mistaken for
+// the one previously read.
+bool stat_identity(const std::string &filename, uint64_t &device,
+        uint64_t &inode) {
+    #ifndef _WIN32
+        struct stat st;
+        if (::stat(filename.c_str(), &st) != 0) {
+            return false;
+        }
+        device = static_cast<uint64_t>(st.st_dev);
+        inode = static_cast<uint64_t>(st.st_ino);
+    #else
+        (void)filename;
+        device = 0;
+        inode = 0;
+    #endif
+    return true;
+}
+}  // namespace
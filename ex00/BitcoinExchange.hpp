@@ -1,14 +1,39 @@
 #pragma once
 
+#include <stdint.h>
+
+#include <cstddef>
 #include <map>
 #include <string>
 #include <stdexcept>
 #include <fstream>
+#include <vector>
 
 #include <ex00/Date.hpp>
+#include <ex00/RateIndex.hpp>
+#include <ex00/DenseRateTable.hpp>
+#include <ex00/CompressedRates.hpp>
+#include <ex00/RateAggregates.hpp>
 
 class BitcoinExchange {
  public:
+    enum LookupMode {
+        BINARY_SEARCH,  // O(log n) search over the sorted rate index
+        DENSE_TABLE,    // O(1) day-indexed table (falls back when too sparse)
+        COMPRESSED      // block-compressed history, one block decoded
+    };
+
+    struct ConversionQuery {
+        toolbox::Date date;
+        double amount;
+    };
+
+    struct ConversionResult {
+        bool found;   // false if there is no rate on or before the date
+        double rate;
+        double value;  // amount * rate (0 if !found)
+    };
+
     BitcoinExchange();
     BitcoinExchange(const BitcoinExchange &other);
     BitcoinExchange &operator=(const BitcoinExchange &other);
@@ -16,9 +41,62 @@ class BitcoinExchange {
 
     explicit BitcoinExchange(const std::string &data_filename);
 
-    void load_data(const std::string &data_filename);
+    void load_data(const std::string &data_filename,
+        std::size_t reported_size = 0);
+    void reload_data(const std::string &data_filename);
+    void save_snapshot(const std::string &snapshot_filename) const;
+    bool load_snapshot(const std::string &snapshot_filename);
     double get_exchange_rate(const toolbox::Date &date) const;
+    bool find_exchange_rate(const toolbox::Date &date, double &rate) const;
+    std::vector<ConversionResult> convert(
+        const std::vector<ConversionQuery> &queries) const;
     bool empty() const;
+
+    double get_rate_sum(const toolbox::Date &from,
+        const toolbox::Date &to) const;
+    double get_min_rate(const toolbox::Date &from,
+        const toolbox::Date &to) const;
+    double get_max_rate(const toolbox::Date &from,
+        const toolbox::Date &to) const;
+    double get_mean_rate(const toolbox::Date &from,
+        const toolbox::Date &to) const;
+
+    void set_lookup_mode(LookupMode mode);
+    LookupMode get_lookup_mode() const;
  private:
-    std::map<toolbox::Date, double> _exchange_rates;
+    // What load_data / reload_data last read from a data file, so that the
+    // next reload can tell rows appended to it from a rewrite.
+    struct DataSource {
+        std::string filename;  // empty if the data did not come from a file
+        uint64_t device;
+        uint64_t inode;
+        std::size_t size;           // bytes ingested
+        std::size_t complete_size;  // bytes up to the last '\n'
+        uint64_t checksum;          // FNV-1a of the bytes ingested
+    };
+
+    // Progress of the lazy build of _aggregates.
+    enum AggregatesState {
+        AGGREGATES_STALE,
+        AGGREGATES_BUILDING,
+        AGGREGATES_BUILT
+    };
+
+    void rebuild_dense_table();
+    void rebuild_compressed_rates();
+    const RateAggregates &aggregates() const;
+    void index_changed();
+    void entry_range(const toolbox::Date &from, const toolbox::Date &to,
+        std::size_t &first, std::size_t &last) const;
+    void remember_source(const std::string &data_filename,
+        const char *data, std::size_t size);
+    void forget_source();
+
+    RateIndex _exchange_rates;
+    DenseRateTable _dense_rates;
+    CompressedRates _compressed_rates;
+    mutable RateAggregates _aggregates;  // built by the first range query
+    mutable int _aggregates_state;       // an AggregatesState
+    LookupMode _lookup_mode;
+    DataSource _source;
 };
@@ -0,0 +1,336 @@
+#include <ex00/CompressedRates.hpp>
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <ex00/RateIndex.hpp>
+
+namespace {
+// Appends bit fields to a stream of 64-bit words, most significant first.
+class BitWriter {
+ public:
+    BitWriter(std::vector<uint64_t> &words, std::size_t position);
+
+    void write(uint64_t value, unsigned count);
+    std::size_t position() const;
+
+ private:
+    std::vector<uint64_t> &_words;
+    std::size_t _position;  // in bits
+};
+
+// Reads back what BitWriter wrote.
+class BitReader {
+ public:
+    BitReader(const uint64_t *words, std::size_t position);
+
+    uint64_t read(unsigned count);
+
+ private:
+    const uint64_t *_words;
+    std::size_t _position;  // in bits
+};
+
+// Window of meaningful bits of the last XOR written with a new window.
+struct XorWindow {
+    unsigned leading;
+    unsigned length;
+};
+
+void write_delta_of_delta(BitWriter &out, int64_t dod);
+int64_t read_delta_of_delta(BitReader &in);
+void write_xor(BitWriter &out, uint64_t value, XorWindow &window);
+uint64_t read_xor(BitReader &in, XorWindow &window);
+uint64_t double_bits(double value);
+double bits_double(uint64_t bits);
+unsigned leading_zeros(uint64_t value);
+unsigned trailing_zeros(uint64_t value);
+}  // namespace
+
+const std::size_t CompressedRates::BLOCK_SIZE;
+
+CompressedRates::CompressedRates()
+    : _block_dates(), _block_bits(), _words(), _size(0) {}
+
+CompressedRates::CompressedRates(const CompressedRates &other)
+    : _block_dates(other._block_dates), _block_bits(other._block_bits),
+    _words(other._words), _size(other._size) {}
+
+CompressedRates &CompressedRates::operator=(const CompressedRates &other) {
+    if (this != &other) {
+        _block_dates = other._block_dates;
+        _block_bits = other._block_bits;
+        _words = other._words;
+        _size = other._size;
+    }
+    return *this;
+}
+
+CompressedRates::~CompressedRates() {}
+
+/*
+ * @brief Packs the whole of index.
+ * @note Each block starts afresh: its first date is in the block index, its
+ *       first rate is written raw, and the date delta is assumed to start
+ *       at one day.
+ * @note [complexity]: O(index.size())
+ */
+void CompressedRates::build(const RateIndex &index) {
+    clear();
+    const int *dates = index.dates();
+    const double *rates = index.rates();
+    const std::size_t n = index.size();
+    std::vector<int> block_dates;
+    std::vector<std::size_t> block_bits;
+    std::vector<uint64_t> words;
+    block_dates.reserve(n / BLOCK_SIZE + 1);
+    block_bits.reserve(n / BLOCK_SIZE + 1);
+    BitWriter out(words, 0);
+    int64_t delta = 1;
+    XorWindow window = {0, 0};
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i % BLOCK_SIZE == 0) {
+            block_dates.push_back(dates[i]);
+            block_bits.push_back(out.position());
+            out.write(double_bits(rates[i]), 64);
+            delta = 1;
+            window.length = 0;
+            continue;
+        }
+        const int64_t next_delta = static_cast<int64_t>(dates[i])
+            - dates[i - 1];
+        write_delta_of_delta(out, next_delta - delta);
+        delta = next_delta;
+        write_xor(out, double_bits(rates[i]) ^ double_bits(rates[i - 1]),
+            window);
+    }
+    std::vector<uint64_t>(words).swap(words);  // drop the spare capacity
+    _block_dates.swap(block_dates);
+    _block_bits.swap(block_bits);
+    _words.swap(words);
+    _size = n;
+}
+
+void CompressedRates::swap(CompressedRates &other) {
+    _block_dates.swap(other._block_dates);
+    _block_bits.swap(other._block_bits);
+    _words.swap(other._words);
+    std::swap(_size, other._size);
+}
+
+void CompressedRates::clear() {
+    CompressedRates().swap(*this);
+}
+
+/*
+ * @brief Looks up the rate in effect on serial_date (the rate of the last
+ *        entry dated on or before it), with the as-of semantics of
+ *        RateIndex::find.
+ * @note [complexity]: O(log(n / BLOCK_SIZE) + BLOCK_SIZE)
+ */
+bool CompressedRates::find(int serial_date, double &rate) const {
+    const std::size_t block = std::upper_bound(_block_dates.begin(),
+        _block_dates.end(), serial_date) - _block_dates.begin();
+    if (block == 0) {
+        return false;
+    }
+    const std::size_t first = (block - 1) * BLOCK_SIZE;
+    const std::size_t count = std::min(BLOCK_SIZE, _size - first);
+    BitReader in(&_words[0], _block_bits[block - 1]);
+    int64_t date = _block_dates[block - 1];
+    uint64_t bits = in.read(64);
+    int64_t delta = 1;
+    XorWindow window = {0, 0};
+    for (std::size_t i = 1; i < count; ++i) {
+        delta += read_delta_of_delta(in);
+        if (date + delta > serial_date) {
+            break;
+        }
+        date += delta;
+        bits ^= read_xor(in, window);
+    }
+    rate = bits_double(bits);
+    return true;
+}
+
+bool CompressedRates::empty() const {
+    return _size == 0;
+}
+
+std::size_t CompressedRates::size() const {
+    return _size;
+}
+
+// Bytes held by the bit stream and the block index.
+std::size_t CompressedRates::memory_size() const {
+    return _words.size() * sizeof(uint64_t)
+        + _block_dates.size() * sizeof(int)
+        + _block_bits.size() * sizeof(std::size_t);
+}
+
+namespace {
+BitWriter::BitWriter(std::vector<uint64_t> &words, std::size_t position)
+    : _words(words), _position(position) {}
+
+// Appends the count (at most 64) low bits of value.
+void BitWriter::write(uint64_t value, unsigned count) {
+    if (count == 0) {
+        return;
+    }
+    if (count < 64) {
+        value &= (static_cast<uint64_t>(1) << count) - 1;
+    }
+    const unsigned offset = static_cast<unsigned>(_position % 64);
+    if (offset == 0) {
+        _words.push_back(0);
+    }
+    const unsigned room = 64 - offset;
+    if (count <= room) {
+        _words.back() |= value << (room - count);
+    } else {
+        _words.back() |= value >> (count - room);
+        _words.push_back(value << (64 - (count - room)));
+    }
+    _position += count;
+}
+
+std::size_t BitWriter::position() const {
+    return _position;
+}
+
+BitReader::BitReader(const uint64_t *words, std::size_t position)
+    : _words(words), _position(position) {}
+
+// Reads count (at most 64) bits.
+uint64_t BitReader::read(unsigned count) {
+    if (count == 0) {
+        return 0;
+    }
+    const std::size_t word = _position / 64;
+    const unsigned offset = static_cast<unsigned>(_position % 64);
+    uint64_t value = _words[word] << offset;
+    if (offset + count > 64) {
+        value |= _words[word + 1] >> (64 - offset);
+    }
+    _position += count;
+    return value >> (64 - count);
+}
+
+/*
+ * Delta-of-delta codes (Gorilla's, with wider buckets for day counts):
+ *   0                       '0'
+ *   [-63, 64]               '10'   + 7 bits
+ *   [-2047, 2048]           '110'  + 12 bits
+ *   [-524287, 524288]       '1110' + 20 bits
+ *   anything else           '1111' + 64 bits
+ */
+void write_delta_of_delta(BitWriter &out, int64_t dod) {
+    if (dod == 0) {
+        out.write(0, 1);
+    } else if (dod >= -63 && dod <= 64) {
+        out.write(2, 2);
+        out.write(static_cast<uint64_t>(dod + 63), 7);
+    } else if (dod >= -2047 && dod <= 2048) {
+        out.write(6, 3);
+        out.write(static_cast<uint64_t>(dod + 2047), 12);
+    } else if (dod >= -524287 && dod <= 524288) {
+        out.write(14, 4);
+        out.write(static_cast<uint64_t>(dod + 524287), 20);
+    } else {
+        out.write(15, 4);
+        out.write(static_cast<uint64_t>(dod), 64);
+    }
+}
+
+int64_t read_delta_of_delta(BitReader &in) {
+    if (in.read(1) == 0) {
+        return 0;
+    }
+    if (in.read(1) == 0) {
+        return static_cast<int64_t>(in.read(7)) - 63;
+    }
+    if (in.read(1) == 0) {
+        return static_cast<int64_t>(in.read(12)) - 2047;
+    }
+    if (in.read(1) == 0) {
+        return static_cast<int64_t>(in.read(20)) - 524287;
+    }
+    return static_cast<int64_t>(in.read(64));
+}
+
+/*
+ * XOR codes (Gorilla's):
+ *   no change               '0'
+ *   fits the last window    '10' + the window's bits
+ *   otherwise               '11' + 5 bits of leading zeros + 6 bits of
+ *                           length (64 written as 0) + the meaningful bits
+ */
+void write_xor(BitWriter &out, uint64_t value, XorWindow &window) {
+    if (value == 0) {
+        out.write(0, 1);
+        return;
+    }
+    const unsigned leading = std::min(leading_zeros(value), 31u);
+    const unsigned trailing = trailing_zeros(value);
+    if (window.length != 0 && leading >= window.leading
+        && trailing >= 64 - window.leading - window.length) {
+        out.write(2, 2);
+        out.write(value >> (64 - window.leading - window.length),
+            window.length);
+        return;
+    }
+    window.leading = leading;
+    window.length = 64 - leading - trailing;
+    out.write(3, 2);
+    out.write(window.leading, 5);
+    out.write(window.length % 64, 6);
+    out.write(value >> trailing, window.length);
+}
+
+uint64_t read_xor(BitReader &in, XorWindow &window) {
+    if (in.read(1) == 0) {
+        return 0;
+    }
+    if (in.read(1) != 0) {
+        window.leading = static_cast<unsigned>(in.read(5));
+        window.length = static_cast<unsigned>(in.read(6));
+        if (window.length == 0) {
+            window.length = 64;
+        }
+    }
+    return in.read(window.length) << (64 - window.leading - window.length);
+}
+
+uint64_t double_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bits_double(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+unsigned leading_zeros(uint64_t value) {
+    unsigned count = 0;
+    for (uint64_t mask = static_cast<uint64_t>(1) << 63;
+        mask != 0 && (value & mask) == 0; mask >>= 1) {
+        ++count;
+    }
+    return count;
+}
+
+unsigned trailing_zeros(uint64_t value) {
+    unsigned count = 0;
+    for (; count < 64 && (value & 1) == 0; value >>= 1) {
+        ++count;
+    }
+    return count;
+}
+}  // namespace
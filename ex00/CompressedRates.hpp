@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <vector>
+
+#include <ex00/RateIndex.hpp>
+
+// Rate history packed into a bit stream, in blocks of BLOCK_SIZE entries:
+// - dates are delta-of-delta encoded (a run of consecutive days costs one
+//   bit per entry),
+// - rates are XORed with the previous rate and only the meaningful bits
+//   are kept (Gorilla-style), so an unchanged rate costs one bit and a
+//   small change a few.
+// A block index (first date and bit position of every block) sends a
+// lookup to one block, which is the only one decoded.
+class CompressedRates {
+ public:
+    static const std::size_t BLOCK_SIZE = 64;
+
+    CompressedRates();
+    CompressedRates(const CompressedRates &other);
+    CompressedRates &operator=(const CompressedRates &other);
+    ~CompressedRates();
+
+    void build(const RateIndex &index);
+    void swap(CompressedRates &other);
+    void clear();
+
+    bool find(int serial_date, double &rate) const;
+
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t memory_size() const;
+
+ private:
+    std::vector<int> _block_dates;          // first date of each block
+    std::vector<std::size_t> _block_bits;   // where each block starts
+    std::vector<uint64_t> _words;           // the bit stream
+    std::size_t _size;                      // entries
+};
@@ -0,0 +1,134 @@
+#include <ex00/ConversionReport.hpp>
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <toolbox/OutputBuffer.hpp>
+#include <toolbox/StepMark.hpp>
+
+namespace {
+bool same_target(int fd1, int fd2);
+bool is_terminal(int fd);
+}  // namespace
+
+void ConversionReport::write(Channel channel, const std::string &text) {
+    write(channel, text.data(), text.size());
+}
+
+StreamReport::StreamReport()
+    : _out(std::cout), _err(std::cerr), _shared_target(same_target(1, 2)) {
+    _out.set_line_buffered(is_terminal(1));
+    _err.set_line_buffered(is_terminal(2));
+}
+
+StreamReport::~StreamReport() {
+    flush();
+}
+
+/*
+ * @note When stdout and stderr go to the same file, the other buffer is
+ *       flushed before switching streams, so the lines come out interleaved
+ *       exactly as they were reported.
+ */
+void StreamReport::write(Channel channel, const char *text,
+        std::size_t size) {
+    switch (channel) {
+        case STDOUT:
+            if (_shared_target && !_err.empty()) {
+                _err.flush();
+            }
+            _out.append(text, size);
+            _out.end_line();
+            break;
+        case STDERR:
+            if (_shared_target && !_out.empty()) {
+                _out.flush();
+            }
+            _err.append(text, size);
+            _err.end_line();
+            break;
+        case LOG_INFO:
+            toolbox::logger::StepMark::info(std::string(text, size));
+            break;
+        case LOG_ERROR:
+            toolbox::logger::StepMark::error(std::string(text, size));
+            break;
+    }
+}
+
+void StreamReport::flush() {
+    _out.flush();
+    _err.flush();
+}
+
+BufferedReport::BufferedReport() : _records(), _text() {}
+
+BufferedReport::BufferedReport(const BufferedReport &other)
+    : _records(other._records), _text(other._text) {}
+
+BufferedReport &BufferedReport::operator=(const BufferedReport &other) {
+    if (this != &other) {
+        _records = other._records;
+        _text = other._text;
+    }
+    return *this;
+}
+
+BufferedReport::~BufferedReport() {}
+
+void BufferedReport::write(Channel channel, const char *text,
+        std::size_t size) {
+    Record record;
+    record.channel = channel;
+    record.offset = _text.size();
+    record.size = size;
+    _records.push_back(record);
+    _text.append(text, size);
+}
+
+// Forwards every record to report, in the order they were written.
+void BufferedReport::replay(ConversionReport &report) const {
+    for (std::size_t i = 0; i < _records.size(); ++i) {
+        report.write(_records[i].channel,
+            _text.data() + _records[i].offset, _records[i].size);
+    }
+}
+
+void BufferedReport::clear() {
+    std::vector<Record>().swap(_records);
+    std::string().swap(_text);
+}
+
+namespace {
+// Without a way to tell, assume the worst case (a shared target).
+bool same_target(int fd1, int fd2) {
+    #ifndef _WIN32
+        struct stat st1;
+        struct stat st2;
+        if (::fstat(fd1, &st1) != 0 || ::fstat(fd2, &st2) != 0) {
+            return true;
+        }
+        return st1.st_dev == st2.st_dev && st1.st_ino == st2.st_ino;
+    #else
+        (void)fd1;
+        (void)fd2;
+        return true;
+    #endif
+}
+
+bool is_terminal(int fd) {
+    #ifndef _WIN32
+        return ::isatty(fd) == 1;
+    #else
+        (void)fd;
+        return true;
+    #endif
+}
+}  // namespace
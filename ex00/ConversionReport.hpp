@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <toolbox/OutputBuffer.hpp>
+
+// Destination of everything convert_and_print reports about an input line:
+// the converted result, the error message, and the matching log entries.
+class ConversionReport {
+ public:
+    enum Channel {
+        STDOUT,
+        STDERR,
+        LOG_INFO,
+        LOG_ERROR
+    };
+
+    virtual ~ConversionReport() {}
+
+    // text is one whole line (without '\n') or one log message.
+    virtual void write(Channel channel, const char *text,
+        std::size_t size) = 0;
+    void write(Channel channel, const std::string &text);
+};
+
+// Writes the reports to std::cout / std::cerr through OutputBuffers and to
+// toolbox::logger::StepMark. Everything still pending is written out when
+// the report is destroyed.
+class StreamReport : public ConversionReport {
+ public:
+    StreamReport();
+    ~StreamReport();
+
+    using ConversionReport::write;
+    void write(Channel channel, const char *text, std::size_t size);
+    void flush();
+
+ private:
+    StreamReport(const StreamReport &other);
+    StreamReport &operator=(const StreamReport &other);
+
+    toolbox::OutputBuffer _out;
+    toolbox::OutputBuffer _err;
+    bool _shared_target;  // stdout and stderr end up in the same file
+};
+
+// Keeps the reports in memory so that a worker thread can convert a chunk
+// of the input while another thread replays earlier chunks in order.
+// The texts are stored back to back in a single arena.
+class BufferedReport : public ConversionReport {
+ public:
+    BufferedReport();
+    BufferedReport(const BufferedReport &other);
+    BufferedReport &operator=(const BufferedReport &other);
+    ~BufferedReport();
+
+    using ConversionReport::write;
+    void write(Channel channel, const char *text, std::size_t size);
+    void replay(ConversionReport &report) const;
+    void clear();
+
+ private:
+    struct Record {
+        Channel channel;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::vector<Record> _records;
+    std::string _text;
+};
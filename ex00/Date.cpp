@@ -78,6 +78,43 @@ toolbox::Date::Date(toolbox::CalendarSystem cal_sys,
     _serial_date = convert_to_serial_date(cal_sys, date_str, format, strict);
 }
 
+toolbox::Date::Date(toolbox::CalendarSystem cal_sys,
+        const std::string& date_str, const DateFormat& format, bool strict) {
+    _serial_date = convert_to_serial_date(cal_sys, date_str, format, strict);
+}
+
+/*
+ * @brief Non-throwing counterpart of the parsing constructors: the date
+ *        becomes date_str if it parses, and is left unchanged otherwise.
+ * @return The outcome, with the message the constructor would throw.
+ * @throw std::invalid_argument only if format is unusable (see
+ *        ICalendarSystem::parse_serial_date).
+ */
+toolbox::ParseResult toolbox::Date::parse(CalendarSystem cal_sys,
+        const std::string& date_str, const char* format, bool strict) {
+    if (!format) {
+        throw std::invalid_argument("Date::parse failed: format is null");
+    }
+    int serial_date;
+    const ParseResult result = get_calendar_system(cal_sys).parse_serial_date(
+        date_str, format, strict, serial_date);
+    if (result.status == ParseResult::OK) {
+        _serial_date = serial_date;
+    }
+    return result;
+}
+
+toolbox::ParseResult toolbox::Date::parse(CalendarSystem cal_sys,
+        const std::string& date_str, const DateFormat& format, bool strict) {
+    int serial_date;
+    const ParseResult result = get_calendar_system(cal_sys).parse_serial_date(
+        date_str, format, strict, serial_date);
+    if (result.status == ParseResult::OK) {
+        _serial_date = serial_date;
+    }
+    return result;
+}
+
 std::string toolbox::Date::to_string(CalendarSystem cal_sys,
         const char* format) const {
     if (!format) {
@@ -88,10 +125,44 @@ std::string toolbox::Date::to_string(CalendarSystem cal_sys,
     return date_str;
 }
 
+std::string toolbox::Date::to_string(CalendarSystem cal_sys,
+        const DateFormat& format) const {
+    std::string date_str;
+    convert_from_serial_date(cal_sys, date_str, format);
+    return date_str;
+}
+
+/*
+ * @brief Writes the date in cal_sys and format into buffer[0, size),
+ *        followed by a '\0', without allocating.
+ * @return The length of the date ('\0' excluded).
+ * @throw std::length_error if it does not fit (see DATE_BUFFER_SIZE).
+ */
+std::size_t toolbox::Date::to_string(CalendarSystem cal_sys, char* buffer,
+        std::size_t size, const DateFormat& format) const {
+    return convert_from_serial_date(cal_sys, buffer, size, format);
+}
+
 int toolbox::Date::get_raw_date() const {
     return _serial_date;
 }
 
+/*
+ * @brief Returns the era, year, month, day and weekday of the date in
+ *        cal_sys, from one conversion.
+ * @note Callers that read several fields of a date keep the CivilDate
+ *       rather than calling get_day, get_month, ... one after the other.
+ */
+toolbox::CivilDate toolbox::Date::get_civil_date(
+        toolbox::CalendarSystem cal_sys) const {
+    ICalendarSystem& calendar_system = get_calendar_system(cal_sys);
+    CivilDate civil;
+    calendar_system.from_serial_date(_serial_date,
+        civil.era, civil.year, civil.month, civil.day);
+    calendar_system.from_serial_date(_serial_date, civil.weekday);
+    return civil;
+}
+
 int toolbox::Date::get_day(toolbox::CalendarSystem cal_sys) const {
     int era, year, month, day;
     convert_from_serial_date(cal_sys, era, year, month, day);
@@ -200,6 +271,20 @@ void toolbox::Date::convert_from_serial_date(toolbox::CalendarSystem cal_sys,
     calendar_system.from_serial_date(_serial_date, date_str, format);
 }
 
+void toolbox::Date::convert_from_serial_date(toolbox::CalendarSystem cal_sys,
+        std::string& date_str, const DateFormat& format) const {
+    ICalendarSystem& calendar_system = get_calendar_system(cal_sys);
+    calendar_system.from_serial_date(_serial_date, date_str, format);
+}
+
+std::size_t toolbox::Date::convert_from_serial_date(
+        toolbox::CalendarSystem cal_sys,
+        char* buffer, std::size_t size, const DateFormat& format) const {
+    ICalendarSystem& calendar_system = get_calendar_system(cal_sys);
+    return calendar_system.from_serial_date(_serial_date, buffer, size,
+        format);
+}
+
 void toolbox::Date::convert_from_serial_date(toolbox::CalendarSystem cal_sys,
         int& day_of_week) const {
     ICalendarSystem& calendar_system = get_calendar_system(cal_sys);
@@ -222,6 +307,13 @@ int toolbox::Date::convert_to_serial_date(toolbox::CalendarSystem cal_sys,
     return calendar_system.to_serial_date(date_str, format, strict);
 }
 
+int toolbox::Date::convert_to_serial_date(toolbox::CalendarSystem cal_sys,
+        const std::string& date_str, const DateFormat& format,
+        bool strict) const {
+    ICalendarSystem& calendar_system = get_calendar_system(cal_sys);
+    return calendar_system.to_serial_date(date_str, format, strict);
+}
+
 // When adding a new calendar system, add it here.
 toolbox::ICalendarSystem& toolbox::Date::get_calendar_system(
         toolbox::CalendarSystem cal_sys) const {
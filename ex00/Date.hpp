@@ -11,6 +11,10 @@
  * (addition, subtraction, comparison) and parsing/formatting date strings
  * based on specified formats.
  *
+ * Code that works in a single calendar known at compile time can use
+ * BasicDate<Calendar> (BasicDate.hpp) instead, which holds the same serial
+ * date but converts without the runtime switch and virtual call.
+ *
  * ## Adding a New Calendar System
  *
  * To add support for a new calendar system, follow these steps:
@@ -37,6 +41,16 @@
  *      const char* format) const`:
  *      Formats the serial date into a string according to the specified
  *      format rules for the new calendar.
+ * - `to_serial_date(const std::string& date_str, const DateFormat& format,
+ *      bool strict) const` and `from_serial_date(int serial_date,
+ *      std::string& date_str, const DateFormat& format) const`:
+ *      The same conversions with a precompiled format (see DateFormat.hpp).
+ *      Falling back to the `const char*` overloads with `format.c_str()` is
+ *      always correct; walking the tokens avoids re-reading the format.
+ * - `is_valid_date(int era, int year, int month, int day) const` and the two
+ *      `parse_serial_date(...)` overloads:
+ *      Non-throwing forms of the conversions above, returning a ParseResult
+ *      instead of throwing on input that does not name a valid date.
  * - `from_serial_date(int serial_date, int& day_of_week) const`:
  *      Calculates the day of the week (usually based on the serial date
  *      modulo 7, but depends on the calendar's week definition if different).
@@ -60,14 +74,25 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <iostream>
 
 #include <ex00/calendar_system/CalendarSystem.hpp>
 #include <ex00/calendar_system/ICalendarSystem.hpp>
+#include <ex00/calendar_system/DateFormat.hpp>
 
 namespace toolbox {
 
+// A date split into the fields of one calendar system.
+struct CivilDate {
+    int era;
+    int year;
+    int month;
+    int day;
+    int weekday;  // 0=Sun, 1=Mon, ..., 6=Sat (as the calendar defines it)
+};
+
 class Date {
  public:
     Date();
@@ -81,11 +106,23 @@ class Date {
     Date(CalendarSystem cal_sys, int era, int year, int month, int day);
     Date(CalendarSystem cal_sys, const std::string& date_str,
         const char* format = "%y-%m-%d", bool strict = true);
+    Date(CalendarSystem cal_sys, const std::string& date_str,
+        const DateFormat& format, bool strict = true);
+
+    ParseResult parse(CalendarSystem cal_sys, const std::string& date_str,
+        const char* format = "%y-%m-%d", bool strict = true);
+    ParseResult parse(CalendarSystem cal_sys, const std::string& date_str,
+        const DateFormat& format, bool strict = true);
 
     std::string to_string(CalendarSystem cal_sys,
         const char* format = "%Y-%M-%D") const;
+    std::string to_string(CalendarSystem cal_sys,
+        const DateFormat& format) const;
+    std::size_t to_string(CalendarSystem cal_sys, char* buffer,
+        std::size_t size, const DateFormat& format) const;
 
     int get_raw_date() const;
+    CivilDate get_civil_date(CalendarSystem cal_sys) const;
     int get_day(CalendarSystem cal_sys) const;
     int get_month(CalendarSystem cal_sys) const;
     int get_year(CalendarSystem cal_sys) const;
@@ -114,6 +151,10 @@ class Date {
         int& era, int& year, int& month, int& day) const;
     void convert_from_serial_date(CalendarSystem cal_sys,
         std::string& date_str, const char* format) const;
+    void convert_from_serial_date(CalendarSystem cal_sys,
+        std::string& date_str, const DateFormat& format) const;
+    std::size_t convert_from_serial_date(CalendarSystem cal_sys,
+        char* buffer, std::size_t size, const DateFormat& format) const;
     void convert_from_serial_date(CalendarSystem cal_sys,
         int& day_of_week) const;
     int convert_to_serial_date(CalendarSystem cal_sys,
@@ -121,6 +162,9 @@ class Date {
     int convert_to_serial_date(CalendarSystem cal_sys,
         const std::string& date_str,
         const char* format, bool strict) const;
+    int convert_to_serial_date(CalendarSystem cal_sys,
+        const std::string& date_str,
+        const DateFormat& format, bool strict) const;
     ICalendarSystem& get_calendar_system(CalendarSystem cal_sys) const;
 
     int _serial_date;  // 0 mean 1970-01-01 (Unix epoch)
@@ -0,0 +1,148 @@
+#include <ex00/DateRateCache.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <toolbox/hash.hpp>
+
+namespace {
+std::size_t round_up_to_power_of_two(std::size_t n);
+}  // namespace
+
+const std::size_t DateRateCache::KEY_SIZE;
+const std::size_t DateRateCache::DEFAULT_CAPACITY;
+
+DateRateCache::DateRateCache()
+    : _entries(DEFAULT_CAPACITY), _mask(DEFAULT_CAPACITY - 1), _size(0),
+      _hits(0), _misses(0) {
+    clear();
+}
+
+DateRateCache::DateRateCache(const DateRateCache &other)
+    : _entries(other._entries), _mask(other._mask), _size(other._size),
+      _hits(other._hits), _misses(other._misses) {}
+
+DateRateCache &DateRateCache::operator=(const DateRateCache &other) {
+    if (this != &other) {
+        _entries = other._entries;
+        _mask = other._mask;
+        _size = other._size;
+        _hits = other._hits;
+        _misses = other._misses;
+    }
+    return *this;
+}
+
+DateRateCache::~DateRateCache() {}
+
+/*
+ * @param capacity Number of slots, rounded up to a power of two (at least 4).
+ */
+DateRateCache::DateRateCache(std::size_t capacity)
+    : _entries(round_up_to_power_of_two(capacity)), _mask(0), _size(0),
+      _hits(0), _misses(0) {
+    _mask = _entries.size() - 1;
+    clear();
+}
+
+/*
+ * @brief Looks up the serial date and rate cached for a date token.
+ * @return false (counted as a miss) if key is not cached, including keys
+ *         that are not KEY_SIZE bytes long.
+ * @note [complexity]: O(1) expected
+ */
+bool DateRateCache::find(const char *key, std::size_t size,
+    int &serial_date, double &rate) {
+    if (size == KEY_SIZE) {
+        for (std::size_t slot = home_slot(key); _entries[slot].used;
+            slot = (slot + 1) & _mask) {
+            const Entry &entry = _entries[slot];
+            if (std::memcmp(entry.key, key, KEY_SIZE) == 0) {
+                serial_date = entry.serial_date;
+                rate = entry.rate;
+                ++_hits;
+                return true;
+            }
+        }
+    }
+    ++_misses;
+    return false;
+}
+
+/*
+ * @brief Caches the serial date and rate of a date token.
+ * @note Keys that are not KEY_SIZE bytes long are ignored. At the load limit
+ *       (3/4 of the slots) a new key overwrites the entry in its home slot,
+ *       or is not cached if that slot is free; no slot is ever emptied, so
+ *       probe chains stay intact.
+ * @note [complexity]: O(1) expected
+ */
+void DateRateCache::insert(const char *key, std::size_t size,
+    int serial_date, double rate) {
+    if (size != KEY_SIZE) {
+        return;
+    }
+    const std::size_t home = home_slot(key);
+    std::size_t slot = home;
+    for (; _entries[slot].used; slot = (slot + 1) & _mask) {
+        if (std::memcmp(_entries[slot].key, key, KEY_SIZE) == 0) {
+            break;
+        }
+    }
+    if (!_entries[slot].used) {
+        if (_size < _entries.size() / 4 * 3) {
+            ++_size;
+        } else if (_entries[home].used) {
+            slot = home;
+        } else {
+            return;
+        }
+    }
+    Entry &entry = _entries[slot];
+    std::memcpy(entry.key, key, KEY_SIZE);
+    entry.used = true;
+    entry.serial_date = serial_date;
+    entry.rate = rate;
+}
+
+// Drops every entry and resets the counters.
+void DateRateCache::clear() {
+    for (std::size_t i = 0; i < _entries.size(); ++i) {
+        _entries[i].used = false;
+    }
+    _size = 0;
+    _hits = 0;
+    _misses = 0;
+}
+
+std::size_t DateRateCache::size() const {
+    return _size;
+}
+
+std::size_t DateRateCache::capacity() const {
+    return _entries.size();
+}
+
+std::size_t DateRateCache::hits() const {
+    return _hits;
+}
+
+std::size_t DateRateCache::misses() const {
+    return _misses;
+}
+
+std::size_t DateRateCache::home_slot(const char *key) const {
+    return static_cast<std::size_t>(toolbox::hash::fnv1a(key, KEY_SIZE))
+        & _mask;
+}
+
+namespace {
+std::size_t round_up_to_power_of_two(std::size_t n) {
+    std::size_t power = 4;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+}  // namespace
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Remembers, for the raw date token of an input line ("2011-01-03"), the
+// serial date it parses to and the rate in effect on it, so that a date
+// repeated across many lines is parsed and looked up once.
+//
+// Fixed-size open-addressing table (linear probing) keyed by the token
+// bytes. Only tokens of exactly KEY_SIZE bytes are cached. Once the table
+// reaches its load limit a new key replaces the entry in its home slot, so
+// memory stays bounded and recent dates keep being served.
+// Not thread-safe: give each converting thread its own cache.
+class DateRateCache {
+ public:
+    static const std::size_t KEY_SIZE = 10;  // "YYYY-MM-DD"
+    static const std::size_t DEFAULT_CAPACITY = 4096;
+
+    DateRateCache();
+    DateRateCache(const DateRateCache &other);
+    DateRateCache &operator=(const DateRateCache &other);
+    ~DateRateCache();
+
+    explicit DateRateCache(std::size_t capacity);
+
+    bool find(const char *key, std::size_t size,
+        int &serial_date, double &rate);
+    void insert(const char *key, std::size_t size,
+        int serial_date, double rate);
+    void clear();
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    std::size_t hits() const;
+    std::size_t misses() const;
+
+ private:
+    struct Entry {
+        char key[KEY_SIZE];
+        bool used;
+        int serial_date;
+        double rate;
+    };
+
+    std::size_t home_slot(const char *key) const;
+
+    std::vector<Entry> _entries;
+    std::size_t _mask;  // capacity - 1 (capacity is a power of two)
+    std::size_t _size;
+    std::size_t _hits;
+    std::size_t _misses;
+};
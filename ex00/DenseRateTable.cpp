@@ -0,0 +1,101 @@
+#include <ex00/DenseRateTable.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <ex00/RateIndex.hpp>
+
+const std::size_t DenseRateTable::DEFAULT_MAX_SPAN;
+
+DenseRateTable::DenseRateTable() : _rates(), _first_serial(0) {}
+
+DenseRateTable::DenseRateTable(const DenseRateTable &other)
+    : _rates(other._rates), _first_serial(other._first_serial) {}
+
+DenseRateTable &DenseRateTable::operator=(const DenseRateTable &other) {
+    if (this != &other) {
+        _rates = other._rates;
+        _first_serial = other._first_serial;
+    }
+    return *this;
+}
+
+DenseRateTable::~DenseRateTable() {}
+
+/*
+ * @brief Expands index into one slot per day between its first and last date.
+ * @param index The sorted history to expand.
+ * @param max_span Upper bound on the number of slots to allocate.
+ * @return false (and leaves the table empty) if index is empty or spans more
+ *         than max_span days.
+ * @note [complexity]: O(last - first + index.size())
+ */
+bool DenseRateTable::build(const RateIndex &index, std::size_t max_span) {
+    clear();
+    if (index.empty()) {
+        return false;
+    }
+    const int *dates = index.dates();
+    const double *rates = index.rates();
+    const std::size_t n = index.size();
+    const double span = static_cast<double>(dates[n - 1])
+        - static_cast<double>(dates[0]) + 1.0;
+    if (span > static_cast<double>(max_span)) {
+        return false;
+    }
+    std::vector<double> table(static_cast<std::size_t>(span));
+    std::size_t slot = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t end = static_cast<std::size_t>(dates[i] - dates[0]);
+        for (; slot < end; ++slot) {
+            table[slot] = rates[i - 1];
+        }
+        table[slot++] = rates[i];
+    }
+    _rates.swap(table);
+    _first_serial = dates[0];
+    return true;
+}
+
+void DenseRateTable::swap(DenseRateTable &other) {
+    _rates.swap(other._rates);
+    const int tmp = _first_serial;
+    _first_serial = other._first_serial;
+    other._first_serial = tmp;
+}
+
+void DenseRateTable::clear() {
+    std::vector<double>().swap(_rates);
+    _first_serial = 0;
+}
+
+/*
+ * @brief Looks up the rate in effect on serial_date.
+ * @note Dates after the last slot resolve to the last rate, matching the
+ *       as-of semantics of RateIndex::find.
+ */
+bool DenseRateTable::find(int serial_date, double &rate) const {
+    if (_rates.empty() || serial_date < _first_serial) {
+        return false;
+    }
+    std::size_t offset = static_cast<std::size_t>(
+        static_cast<unsigned int>(serial_date)
+        - static_cast<unsigned int>(_first_serial));
+    if (offset >= _rates.size()) {
+        offset = _rates.size() - 1;
+    }
+    rate = _rates[offset];
+    return true;
+}
+
+bool DenseRateTable::empty() const {
+    return _rates.empty();
+}
+
+std::size_t DenseRateTable::span() const {
+    return _rates.size();
+}
+
+int DenseRateTable::first_serial() const {
+    return _first_serial;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <ex00/RateIndex.hpp>
+
+// Day-indexed rate table: slot i holds the rate in effect on day
+// (first_serial + i), gaps being filled with the most recent earlier rate.
+// A lookup is a bounds check plus a single array load.
+class DenseRateTable {
+ public:
+    DenseRateTable();
+    DenseRateTable(const DenseRateTable &other);
+    DenseRateTable &operator=(const DenseRateTable &other);
+    ~DenseRateTable();
+
+    bool build(const RateIndex &index, std::size_t max_span);
+    void swap(DenseRateTable &other);
+    void clear();
+
+    bool find(int serial_date, double &rate) const;
+
+    bool empty() const;
+    std::size_t span() const;
+    int first_serial() const;
+
+    // 2^20 days is about 2,870 years (8 MiB of rates).
+    static const std::size_t DEFAULT_MAX_SPAN = 1 << 20;
+
+ private:
+    std::vector<double> _rates;
+    int _first_serial;
+};
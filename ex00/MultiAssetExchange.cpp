@@ -0,0 +1,307 @@
+#include <ex00/MultiAssetExchange.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ex00/BasicDate.hpp>
+#include <ex00/Date.hpp>
+#include <ex00/RateIndex.hpp>
+#include <ex00/RateStream.hpp>
+#include <ex00/calendar_system/GregorianCalendar.hpp>
+#include <toolbox/MappedFile.hpp>
+#include <toolbox/StepMark.hpp>
+#include <toolbox/string.hpp>
+
+namespace {
+typedef toolbox::BasicDate<toolbox::GregorianCalendar> GregorianDate;
+
+const toolbox::DateFormat date_format("%Y-%m-%d");
+
+std::size_t split_cells(const char *begin, const char *end,
+    std::vector<std::pair<const char *, const char *> > &cells);
+}  // namespace
+
+MultiAssetExchange::MultiAssetExchange()
+    : _assets(), _dates(), _rates(), _first_row() {}
+
+MultiAssetExchange::MultiAssetExchange(const MultiAssetExchange &other)
+    : _assets(other._assets), _dates(other._dates), _rates(other._rates),
+    _first_row(other._first_row) {}
+
+MultiAssetExchange &MultiAssetExchange::operator=(
+        const MultiAssetExchange &other) {
+    if (this != &other) {
+        _assets = other._assets;
+        _dates = other._dates;
+        _rates = other._rates;
+        _first_row = other._first_row;
+    }
+    return *this;
+}
+
+MultiAssetExchange::~MultiAssetExchange() {}
+
+MultiAssetExchange::MultiAssetExchange(const std::string &data_filename)
+    : _assets(), _dates(), _rates(), _first_row() {
+    load_data(data_filename);
+}
+
+/*
+ * @brief Loads a wide CSV: a "date,<asset>,<asset>,..." header, then one
+ *        row per date with one cell per asset.
+ * @note A line with the wrong number of cells or an invalid date is
+ *       ignored; an empty cell means "no quote on that date", and a cell
+ *       that is not a non-negative number is ignored the same way. A date
+ *       given twice keeps the cells of its later rows and is reported as
+ *       a duplicate.
+ * @note Each row costs one date parse, whatever the number of assets.
+ */
+void MultiAssetExchange::load_data(const std::string &data_filename) {
+    toolbox::logger::StepMark::info(std::string(
+        "Loading multi-asset exchange rate data from file: ")
+        + data_filename);
+    clear();
+    toolbox::MappedFile file;
+    if (!file.open(data_filename)) {
+        std::cerr << "Warning: failed to open data file: " << data_filename
+            << " (the database will be empty)" << std::endl;
+        toolbox::logger::StepMark::warning(std::string(
+            "Failed to open data file: ") + data_filename);
+        return;
+    }
+    const char *cursor = file.data();
+    const char *const end = cursor + file.size();
+    const char *line_begin;
+    const char *line_end;
+    if (!toolbox::next_line(cursor, end, line_begin, line_end)) {
+        std::cerr << "Warning: data file is empty: " << data_filename
+            << " (the database will be empty)" << std::endl;
+        toolbox::logger::StepMark::warning(std::string(
+            "Data file is empty: ") + data_filename);
+        return;
+    }
+    std::vector<std::pair<const char *, const char *> > cells;
+    const std::size_t columns = split_cells(line_begin, line_end, cells);
+    const char header[] = "date";
+    if (columns < 2
+        || static_cast<std::size_t>(cells[0].second - cells[0].first)
+            != sizeof(header) - 1
+        || std::memcmp(cells[0].first, header, sizeof(header) - 1) != 0) {
+        std::cerr << "Warning: invalid header in data file: " << data_filename
+            << " (Expecting 'date,<asset>,...'; the database will be empty)"
+            << std::endl;
+        toolbox::logger::StepMark::warning(std::string(
+            "Invalid multi-asset header in data file: ") + data_filename);
+        return;
+    }
+    std::vector<std::string> assets;
+    for (std::size_t i = 1; i < columns; ++i) {
+        assets.push_back(std::string(cells[i].first, cells[i].second));
+    }
+    const std::size_t asset_count = assets.size();
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+
+    // Rows as read: one date, the line and asset_count cells (NaN when
+    // missing).
+    std::vector<std::pair<int, std::size_t> > rows;
+    std::vector<std::pair<const char *, const char *> > lines;
+    std::vector<double> cells_read;
+    std::string date_str;
+    while (toolbox::next_line(cursor, end, line_begin, line_end)) {
+        if (split_cells(line_begin, line_end, cells) != columns) {
+            const std::string line(line_begin, line_end);
+            std::cerr << "Warning: invalid line format "
+                << "(wrong number of cells) in data file: "
+                << line << " (this line will be ignored)" << std::endl;
+            toolbox::logger::StepMark::warning(std::string(
+                "Ignoring malformed line (wrong number of cells): ") + line);
+            continue;
+        }
+        date_str.assign(cells[0].first, cells[0].second);
+        GregorianDate date;
+        const toolbox::ParseResult parsed
+            = date.parse(date_str, date_format, true);
+        if (parsed.status != toolbox::ParseResult::OK) {
+            const std::string line(line_begin, line_end);
+            std::cerr << "Warning: invalid data in line: " << line
+                << " (" << parsed.message << ") (this line will be ignored)"
+                << std::endl;
+            toolbox::logger::StepMark::warning(std::string(
+                "Ignoring invalid data line: ") + line + " ("
+                + parsed.message + ")");
+            continue;
+        }
+        rows.push_back(std::make_pair(date.get_raw_date(), rows.size()));
+        lines.push_back(std::make_pair(line_begin, line_end));
+        for (std::size_t i = 1; i < columns; ++i) {
+            double value = missing;
+            if (cells[i].first != cells[i].second
+                && (!toolbox::parse_double(cells[i].first,
+                        cells[i].second - cells[i].first, value)
+                    || value < 0.0)) {
+                const std::string cell(cells[i].first, cells[i].second);
+                std::cerr << "Warning: invalid rate for " << assets[i - 1]
+                    << " on " << date_str << ": " << cell
+                    << " (this cell will be ignored)" << std::endl;
+                toolbox::logger::StepMark::warning("Ignoring invalid rate "
+                    "for " + assets[i - 1] + " on " + date_str + ": "
+                    + cell);
+                value = missing;
+            }
+            cells_read.push_back(value);
+        }
+    }
+
+    // Order the rows by date (file order among equal dates), merge repeated
+    // dates cell by cell, then lay the columns out with as-of filling.
+    std::stable_sort(rows.begin(), rows.end());
+    std::vector<int> dates;
+    std::vector<double> merged;
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const double *row = &cells_read[rows[i].second * asset_count];
+        if (!dates.empty() && dates.back() == rows[i].first) {
+            report_duplicate_rate(lines[rows[i].second].first,
+                lines[rows[i].second].second);
+            double *target = &merged[merged.size() - asset_count];
+            for (std::size_t a = 0; a < asset_count; ++a) {
+                if (row[a] == row[a]) {
+                    target[a] = row[a];
+                }
+            }
+            continue;
+        }
+        dates.push_back(rows[i].first);
+        merged.insert(merged.end(), row, row + asset_count);
+    }
+    const std::size_t row_count = dates.size();
+    std::vector<double> rates(asset_count * row_count, 0.0);
+    std::vector<std::size_t> first_row(asset_count, row_count);
+    for (std::size_t a = 0; a < asset_count; ++a) {
+        double *column = rates.empty() ? NULL : &rates[a * row_count];
+        for (std::size_t r = 0; r < row_count; ++r) {
+            const double value = merged[r * asset_count + a];
+            if (value == value) {
+                column[r] = value;
+                if (first_row[a] == row_count) {
+                    first_row[a] = r;
+                }
+            } else if (r > 0) {
+                column[r] = column[r - 1];
+            }
+        }
+    }
+    _assets.swap(assets);
+    _dates.swap(dates);
+    _rates.swap(rates);
+    _first_row.swap(first_row);
+    std::ostringstream oss;
+    oss << "Multi-asset exchange rate data loaded. Assets: "
+        << _assets.size() << ", dates: " << _dates.size();
+    toolbox::logger::StepMark::info(oss.str());
+}
+
+std::size_t MultiAssetExchange::asset_count() const {
+    return _assets.size();
+}
+
+const std::string &MultiAssetExchange::asset_name(std::size_t asset) const {
+    return _assets.at(asset);
+}
+
+/*
+ * @brief Returns the column of the asset called name.
+ * @throw std::out_of_range if there is no such asset.
+ */
+std::size_t MultiAssetExchange::asset_index(const std::string &name) const {
+    for (std::size_t i = 0; i < _assets.size(); ++i) {
+        if (_assets[i] == name) {
+            return i;
+        }
+    }
+    throw std::out_of_range("Unknown asset: " + name);
+}
+
+/*
+ * @brief Returns the latest rate of asset on or before date.
+ * @throw std::out_of_range if asset does not exist or has no rate on or
+ *        before date.
+ */
+double MultiAssetExchange::get_exchange_rate(std::size_t asset,
+        const toolbox::Date &date) const {
+    if (asset >= _assets.size()) {
+        throw std::out_of_range("Asset index out of range");
+    }
+    const std::size_t pos = RateIndex::upper_bound(
+        _dates.empty() ? NULL : &_dates[0], _dates.size(),
+        date.get_raw_date());
+    if (pos == 0 || pos - 1 < _first_row[asset]) {
+        throw std::out_of_range(
+            "No exchange rate data available for the given date or earlier");
+    }
+    return _rates[asset * _dates.size() + pos - 1];
+}
+
+/*
+ * @brief Looks up every asset on date with a single date search.
+ * @param rates, found Arrays of asset_count() elements; found[a] tells
+ *        whether rates[a] was set.
+ * @return The number of assets with a rate on or before date.
+ */
+std::size_t MultiAssetExchange::get_exchange_rates(const toolbox::Date &date,
+        double *rates, bool *found) const {
+    const std::size_t row_count = _dates.size();
+    const std::size_t pos = RateIndex::upper_bound(
+        _dates.empty() ? NULL : &_dates[0], row_count, date.get_raw_date());
+    std::size_t hits = 0;
+    for (std::size_t a = 0; a < _assets.size(); ++a) {
+        found[a] = pos != 0 && pos - 1 >= _first_row[a];
+        if (found[a]) {
+            rates[a] = _rates[a * row_count + pos - 1];
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+// The number of distinct dates.
+std::size_t MultiAssetExchange::size() const {
+    return _dates.size();
+}
+
+bool MultiAssetExchange::empty() const {
+    return _dates.empty();
+}
+
+void MultiAssetExchange::clear() {
+    std::vector<std::string>().swap(_assets);
+    std::vector<int>().swap(_dates);
+    std::vector<double>().swap(_rates);
+    std::vector<std::size_t>().swap(_first_row);
+}
+
+namespace {
+// Splits [begin, end) at every ','; returns the number of cells.
+std::size_t split_cells(const char *begin, const char *end,
+        std::vector<std::pair<const char *, const char *> > &cells) {
+    cells.clear();
+    const char *cell = begin;
+    for (;;) {
+        const char *comma = static_cast<const char *>(
+            std::memchr(cell, ',', end - cell));
+        if (comma == NULL) {
+            cells.push_back(std::make_pair(cell, end));
+            return cells.size();
+        }
+        cells.push_back(std::make_pair(cell, comma));
+        cell = comma + 1;
+    }
+}
+}  // namespace
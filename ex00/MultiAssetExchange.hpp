@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <ex00/Date.hpp>
+
+// Exchange rates of several assets against one shared date column, loaded
+// from a wide CSV ("date,BTC,ETH,..."), stored column by column.
+//
+// The dates are kept once, sorted; each asset owns a contiguous column of
+// as-of rates aligned with them (a row without a quote for an asset carries
+// the asset's previous rate forward). One date search therefore yields the
+// row for every asset.
+class MultiAssetExchange {
+ public:
+    MultiAssetExchange();
+    MultiAssetExchange(const MultiAssetExchange &other);
+    MultiAssetExchange &operator=(const MultiAssetExchange &other);
+    ~MultiAssetExchange();
+
+    explicit MultiAssetExchange(const std::string &data_filename);
+
+    void load_data(const std::string &data_filename);
+
+    std::size_t asset_count() const;
+    const std::string &asset_name(std::size_t asset) const;
+    std::size_t asset_index(const std::string &name) const;
+
+    double get_exchange_rate(std::size_t asset,
+        const toolbox::Date &date) const;
+    std::size_t get_exchange_rates(const toolbox::Date &date,
+        double *rates, bool *found) const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+ private:
+    void clear();
+
+    std::vector<std::string> _assets;
+    std::vector<int> _dates;
+    std::vector<double> _rates;  // asset a, row r at _rates[a * rows + r]
+    std::vector<std::size_t> _first_row;  // first row quoting each asset
+};
@@ -0,0 +1,162 @@
+#include <ex00/RateAggregates.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <ex00/RateIndex.hpp>
+
+const std::size_t RateAggregates::BLOCK_SIZE;
+
+namespace {
+// floor(log2(n)) for n >= 1
+std::size_t floor_log2(std::size_t n) {
+    std::size_t log = 0;
+    while (n >>= 1) {
+        ++log;
+    }
+    return log;
+}
+}  // namespace
+
+RateAggregates::RateAggregates()
+    : _rates(), _prefix(), _block_min(), _block_max() {}
+
+RateAggregates::RateAggregates(const RateAggregates &other)
+    : _rates(other._rates), _prefix(other._prefix),
+    _block_min(other._block_min), _block_max(other._block_max) {}
+
+RateAggregates &RateAggregates::operator=(const RateAggregates &other) {
+    if (this != &other) {
+        _rates = other._rates;
+        _prefix = other._prefix;
+        _block_min = other._block_min;
+        _block_max = other._block_max;
+    }
+    return *this;
+}
+
+RateAggregates::~RateAggregates() {}
+
+/*
+ * @brief Precomputes the aggregates of the rates of index.
+ * @note [complexity]: O(n) time, O(n) space (the sparse table has
+ *       (n / BLOCK_SIZE) log(n / BLOCK_SIZE) entries per aggregate)
+ */
+void RateAggregates::build(const RateIndex &index) {
+    const std::size_t n = index.size();
+    std::vector<double> rates(index.rates(), index.rates() + n);
+    std::vector<long double> prefix(n + 1);
+    prefix[0] = 0.0L;
+    for (std::size_t i = 0; i < n; ++i) {
+        prefix[i + 1] = prefix[i] + rates[i];
+    }
+    const std::size_t blocks = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::vector<std::vector<double> > block_min;
+    std::vector<std::vector<double> > block_max;
+    if (blocks != 0) {
+        block_min.resize(floor_log2(blocks) + 1);
+        block_max.resize(block_min.size());
+        block_min[0].resize(blocks);
+        block_max[0].resize(blocks);
+        for (std::size_t b = 0; b < blocks; ++b) {
+            const std::size_t first = b * BLOCK_SIZE;
+            const std::size_t last = std::min(first + BLOCK_SIZE, n);
+            block_min[0][b] = *std::min_element(&rates[first],
+                &rates[0] + last);
+            block_max[0][b] = *std::max_element(&rates[first],
+                &rates[0] + last);
+        }
+        for (std::size_t k = 1; k < block_min.size(); ++k) {
+            const std::size_t half = static_cast<std::size_t>(1) << (k - 1);
+            const std::size_t count = blocks - 2 * half + 1;
+            block_min[k].resize(count);
+            block_max[k].resize(count);
+            for (std::size_t b = 0; b < count; ++b) {
+                block_min[k][b] = std::min(block_min[k - 1][b],
+                    block_min[k - 1][b + half]);
+                block_max[k][b] = std::max(block_max[k - 1][b],
+                    block_max[k - 1][b + half]);
+            }
+        }
+    }
+    _rates.swap(rates);
+    _prefix.swap(prefix);
+    _block_min.swap(block_min);
+    _block_max.swap(block_max);
+}
+
+void RateAggregates::clear() {
+    std::vector<double>().swap(_rates);
+    std::vector<long double>().swap(_prefix);
+    std::vector<std::vector<double> >().swap(_block_min);
+    std::vector<std::vector<double> >().swap(_block_max);
+}
+
+/*
+ * @brief Sum of the rates of entries [first, last).
+ * @note [constraint]: first <= last <= size()
+ * @note [complexity]: O(1)
+ */
+double RateAggregates::sum(std::size_t first, std::size_t last) const {
+    if (first >= last) {
+        return 0.0;
+    }
+    return static_cast<double>(_prefix[last] - _prefix[first]);
+}
+
+/*
+ * @brief Smallest rate of entries [first, last).
+ * @note [constraint]: first < last <= size()
+ * @note [complexity]: O(BLOCK_SIZE)
+ */
+double RateAggregates::min(std::size_t first, std::size_t last) const {
+    return query(first, last, true);
+}
+
+/*
+ * @brief Largest rate of entries [first, last).
+ * @note [constraint]: first < last <= size()
+ * @note [complexity]: O(BLOCK_SIZE)
+ */
+double RateAggregates::max(std::size_t first, std::size_t last) const {
+    return query(first, last, false);
+}
+
+std::size_t RateAggregates::size() const {
+    return _rates.size();
+}
+
+double RateAggregates::scan(std::size_t first, std::size_t last,
+        bool want_min) const {
+    const double *begin = &_rates[0] + first;
+    const double *end = &_rates[0] + last;
+    return want_min ? *std::min_element(begin, end)
+        : *std::max_element(begin, end);
+}
+
+double RateAggregates::query(std::size_t first, std::size_t last,
+        bool want_min) const {
+    const std::size_t first_full = (first + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const std::size_t last_full = last / BLOCK_SIZE;  // exclusive
+    if (first_full >= last_full) {
+        return scan(first, last, want_min);
+    }
+    const std::vector<std::vector<double> > &table
+        = want_min ? _block_min : _block_max;
+    const std::size_t k = floor_log2(last_full - first_full);
+    double result = want_min
+        ? std::min(table[k][first_full],
+            table[k][last_full - (static_cast<std::size_t>(1) << k)])
+        : std::max(table[k][first_full],
+            table[k][last_full - (static_cast<std::size_t>(1) << k)]);
+    if (first < first_full * BLOCK_SIZE) {
+        const double head = scan(first, first_full * BLOCK_SIZE, want_min);
+        result = want_min ? std::min(result, head) : std::max(result, head);
+    }
+    if (last_full * BLOCK_SIZE < last) {
+        const double tail = scan(last_full * BLOCK_SIZE, last, want_min);
+        result = want_min ? std::min(result, tail) : std::max(result, tail);
+    }
+    return result;
+}
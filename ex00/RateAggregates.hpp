@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <ex00/RateIndex.hpp>
+
+// Range aggregates (sum, min, max) over the entries of a RateIndex,
+// addressed by entry position [first, last).
+// Sums come from prefix sums kept in long double; min and max come from a
+// sparse table over blocks of BLOCK_SIZE entries, the partial blocks at
+// both ends of a range being scanned directly.
+class RateAggregates {
+ public:
+    RateAggregates();
+    RateAggregates(const RateAggregates &other);
+    RateAggregates &operator=(const RateAggregates &other);
+    ~RateAggregates();
+
+    void build(const RateIndex &index);
+    void clear();
+
+    double sum(std::size_t first, std::size_t last) const;
+    double min(std::size_t first, std::size_t last) const;
+    double max(std::size_t first, std::size_t last) const;
+
+    std::size_t size() const;
+
+    static const std::size_t BLOCK_SIZE = 32;
+
+ private:
+    double scan(std::size_t first, std::size_t last, bool want_min) const;
+    double query(std::size_t first, std::size_t last, bool want_min) const;
+
+    std::vector<double> _rates;
+    std::vector<long double> _prefix;  // _prefix[i] = sum of _rates[0, i)
+    // Level k holds, for each block b, the min (max) of blocks [b, b + 2^k).
+    std::vector<std::vector<double> > _block_min;
+    std::vector<std::vector<double> > _block_max;
+};
@@ -0,0 +1,364 @@
+#include <ex00/RateIndex.hpp>
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <toolbox/MappedFile.hpp>
+#include <toolbox/hash.hpp>
+
+namespace {
+// Snapshot layout (native byte order, checked through byte_order_mark):
+//   offset  0  char[8]   magic "BTCRATES"
+//   offset  8  uint32_t  version
+//   offset 12  uint32_t  byte_order_mark
+//   offset 16  uint64_t  number of entries (n)
+//   offset 24  uint64_t  FNV-1a checksum of everything after the header
+//   offset 32  int32_t   dates[n]
+//              padding to a multiple of 8
+//              double    rates[n]
+const char snapshot_magic[8] = {'B', 'T', 'C', 'R', 'A', 'T', 'E', 'S'};
+const uint32_t snapshot_version = 1;
+const uint32_t byte_order_mark = 0x01020304;
+const std::size_t header_size = 32;
+// The dates are copied as they are stored in RateIndex.
+typedef char int_is_32_bits[sizeof(int) == sizeof(int32_t) ? 1 : -1];
+
+std::size_t rates_offset(std::size_t n);
+}  // namespace
+
+RateIndex::RateIndex() : _dates(), _rates() {}
+
+RateIndex::RateIndex(const RateIndex &other)
+    : _dates(other._dates), _rates(other._rates) {}
+
+RateIndex &RateIndex::operator=(const RateIndex &other) {
+    if (this != &other) {
+        _dates = other._dates;
+        _rates = other._rates;
+    }
+    return *this;
+}
+
+RateIndex::~RateIndex() {}
+
+/*
+ * @brief Takes over the contents of dates and rates (both are left empty).
+ * @note [constraint]: dates is strictly increasing and
+ *       dates.size() == rates.size()
+ */
+void RateIndex::assign(std::vector<int> &dates, std::vector<double> &rates) {
+    _dates.swap(dates);
+    _rates.swap(rates);
+    std::vector<int>().swap(dates);
+    std::vector<double>().swap(rates);
+}
+
+void RateIndex::swap(RateIndex &other) {
+    _dates.swap(other._dates);
+    _rates.swap(other._rates);
+}
+
+void RateIndex::clear() {
+    std::vector<int>().swap(_dates);
+    std::vector<double>().swap(_rates);
+}
+
+/*
+ * @brief Looks up the rate in effect on serial_date.
+ * @param serial_date The date to look up.
+ * @param rate Receives the rate of the latest entry not after serial_date.
+ * @return false if every entry is after serial_date (or the index is empty).
+ */
+bool RateIndex::find(int serial_date, double &rate) const {
+    const std::size_t pos = upper_bound(serial_date);
+    if (pos == 0) {
+        return false;
+    }
+    rate = _rates[pos - 1];
+    return true;
+}
+
+// Returns the number of entries whose date is <= serial_date.
+std::size_t RateIndex::upper_bound(int serial_date) const {
+    return upper_bound(dates(), _dates.size(), serial_date);
+}
+
+/*
+ * @brief Returns the number of elements of the sorted array dates[0, size)
+ *        that are <= serial_date.
+ * @note The loop body has no data-dependent branch: the comparison result
+ *       only selects the next base pointer, so the compiler emits a
+ *       conditional move and the CPU never mispredicts on the search path.
+ * @note [complexity]: O(log n)
+ */
+std::size_t RateIndex::upper_bound(const int *dates, std::size_t size,
+        int serial_date) {
+    std::size_t n = size;
+    if (n == 0) {
+        return 0;
+    }
+    const int *base = dates;
+    while (n > 1) {
+        const std::size_t half = n / 2;
+        base = (base[half] <= serial_date) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - dates) + (*base <= serial_date);
+}
+
+/*
+ * @brief upper_bound for a key known to be >= every date before hint.
+ * @param hint A previous result of upper_bound for a smaller or equal key.
+ * @note Gallops forward from hint (1, 2, 4, ... entries) and then bisects
+ *       the last step, so a sequence of increasing keys walks the index once.
+ * @note [complexity]: O(log d) where d is the distance from hint to the result
+ */
+std::size_t RateIndex::upper_bound_from(std::size_t hint,
+        int serial_date) const {
+    const std::size_t n = _dates.size();
+    if (hint >= n || _dates[hint] > serial_date) {
+        return hint;
+    }
+    std::size_t lo = hint;  // _dates[lo] <= serial_date
+    std::size_t step = 1;
+    while (lo + step < n && _dates[lo + step] <= serial_date) {
+        lo += step;
+        step *= 2;
+    }
+    std::size_t hi = (lo + step < n) ? lo + step : n;  // first candidate > key
+    while (hi - lo > 1) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (_dates[mid] <= serial_date) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return hi;
+}
+
+std::size_t RateIndex::size() const {
+    return _dates.size();
+}
+
+bool RateIndex::empty() const {
+    return _dates.empty();
+}
+
+const int *RateIndex::dates() const {
+    return _dates.empty() ? NULL : &_dates[0];
+}
+
+const double *RateIndex::rates() const {
+    return _rates.empty() ? NULL : &_rates[0];
+}
+
+/*
+ * @brief Saves the index to filename as a binary snapshot.
+ * @throw std::runtime_error if the file cannot be written.
+ * @note The snapshot is written next to filename and renamed over it once
+ *       complete, so a reader never sees a partially written snapshot.
+ */
+void RateIndex::write_snapshot(const std::string &filename) const {
+    const std::size_t n = _dates.size();
+    const std::size_t offset = rates_offset(n);
+    std::vector<char> payload(offset - header_size + n * sizeof(double), 0);
+    if (n != 0) {
+        std::memcpy(&payload[0], &_dates[0], n * sizeof(int32_t));
+        std::memcpy(&payload[offset - header_size], &_rates[0],
+            n * sizeof(double));
+    }
+    const uint64_t count = n;
+    const uint64_t checksum = toolbox::hash::fnv1a(
+        payload.empty() ? NULL : &payload[0], payload.size());
+    char header[header_size];
+    std::memcpy(header, snapshot_magic, sizeof(snapshot_magic));
+    std::memcpy(header + 8, &snapshot_version, sizeof(snapshot_version));
+    std::memcpy(header + 12, &byte_order_mark, sizeof(byte_order_mark));
+    std::memcpy(header + 16, &count, sizeof(count));
+    std::memcpy(header + 24, &checksum, sizeof(checksum));
+
+    const std::string tmp_filename = filename + ".tmp";
+    std::ofstream file(tmp_filename.c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to create snapshot file: "
+            + tmp_filename);
+    }
+    file.write(header, header_size);
+    if (!payload.empty()) {
+        file.write(&payload[0], payload.size());
+    }
+    file.close();
+    if (!file || std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp_filename.c_str());
+        throw std::runtime_error("Failed to write snapshot file: "
+            + filename);
+    }
+}
+
+/*
+ * @brief Replaces the contents of the index with the snapshot in filename.
+ * @throw std::runtime_error if the file cannot be read, is not a snapshot
+ *        (of this version and byte order), is truncated, fails the checksum
+ *        or has dates out of order. The index is left unchanged in that
+ *        case.
+ * @note The rates are not validated again: the snapshot was written from
+ *       an index, and the checksum guards against it having been altered.
+ *       The dates are, since every lookup relies on their order.
+ * @note [complexity]: O(n), two block copies out of the mapped file
+ */
+void RateIndex::read_snapshot(const std::string &filename) {
+    toolbox::MappedFile file;
+    if (!file.open(filename)) {
+        throw std::runtime_error("Failed to open snapshot file: " + filename);
+    }
+    const char *data = file.data();
+    uint32_t version;
+    uint32_t order;
+    uint64_t count;
+    uint64_t checksum;
+    if (file.size() < header_size
+        || std::memcmp(data, snapshot_magic, sizeof(snapshot_magic)) != 0) {
+        throw std::runtime_error("Not a rate snapshot file: " + filename);
+    }
+    std::memcpy(&version, data + 8, sizeof(version));
+    std::memcpy(&order, data + 12, sizeof(order));
+    std::memcpy(&count, data + 16, sizeof(count));
+    std::memcpy(&checksum, data + 24, sizeof(checksum));
+    if (version != snapshot_version || order != byte_order_mark) {
+        throw std::runtime_error("Unsupported rate snapshot version "
+            "or byte order: " + filename);
+    }
+    const std::size_t max_count = file.size() / (sizeof(int32_t)
+        + sizeof(double));
+    const std::size_t n = static_cast<std::size_t>(count);
+    if (count > max_count
+        || file.size() != rates_offset(n) + n * sizeof(double)) {
+        throw std::runtime_error("Truncated rate snapshot file: " + filename);
+    }
+    if (toolbox::hash::fnv1a(data + header_size,
+            file.size() - header_size) != checksum) {
+        throw std::runtime_error("Corrupted rate snapshot file "
+            "(checksum mismatch): " + filename);
+    }
+    std::vector<int> dates(n);
+    std::vector<double> rates(n);
+    if (n != 0) {
+        std::memcpy(&dates[0], data + header_size, n * sizeof(int32_t));
+        std::memcpy(&rates[0], data + rates_offset(n), n * sizeof(double));
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        if (dates[i - 1] >= dates[i]) {
+            throw std::runtime_error("Rate snapshot dates are not in "
+                "increasing order: " + filename);
+        }
+    }
+    assign(dates, rates);
+}
+
+RateIndexBuilder::RateIndexBuilder() : _dates(), _rates(), _unordered() {}
+
+RateIndexBuilder::RateIndexBuilder(const RateIndexBuilder &other)
+    : _dates(other._dates), _rates(other._rates),
+    _unordered(other._unordered) {}
+
+RateIndexBuilder &RateIndexBuilder::operator=(const RateIndexBuilder &other) {
+    if (this != &other) {
+        _dates = other._dates;
+        _rates = other._rates;
+        _unordered = other._unordered;
+    }
+    return *this;
+}
+
+RateIndexBuilder::~RateIndexBuilder() {}
+
+/*
+ * @brief Starts over from the entries of index, so that further rows are
+ *        merged into an existing history.
+ * @note [complexity]: O(n), a copy of both arrays
+ */
+void RateIndexBuilder::assign(const RateIndex &index) {
+    _dates.assign(index.dates(), index.dates() + index.size());
+    _rates.assign(index.rates(), index.rates() + index.size());
+    _unordered.clear();
+}
+
+/*
+ * @brief Records the rate for serial_date, replacing any earlier row.
+ * @return true if a row for serial_date had already been inserted.
+ * @note [complexity]: amortized O(1) for rows in date order,
+ *       O(log n) otherwise
+ */
+bool RateIndexBuilder::insert(int serial_date, double rate) {
+    if (_dates.empty() || _dates.back() < serial_date) {
+        _dates.push_back(serial_date);
+        _rates.push_back(rate);
+        return false;
+    }
+    std::vector<int>::iterator it = std::lower_bound(
+        _dates.begin(), _dates.end(), serial_date);
+    if (*it == serial_date) {
+        _rates[it - _dates.begin()] = rate;
+        return true;
+    }
+    std::pair<std::map<int, double>::iterator, bool> res
+        = _unordered.insert(std::make_pair(serial_date, rate));
+    if (!res.second) {
+        res.first->second = rate;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * @brief Moves every collected row into index; the builder is left empty.
+ */
+void RateIndexBuilder::build(RateIndex &index) {
+    if (!_unordered.empty()) {
+        std::vector<int> dates;
+        std::vector<double> rates;
+        dates.reserve(size());
+        rates.reserve(size());
+        std::size_t i = 0;
+        std::map<int, double>::const_iterator it = _unordered.begin();
+        while (i < _dates.size() || it != _unordered.end()) {
+            if (it == _unordered.end()
+                || (i < _dates.size() && _dates[i] < it->first)) {
+                dates.push_back(_dates[i]);
+                rates.push_back(_rates[i]);
+                ++i;
+            } else {
+                dates.push_back(it->first);
+                rates.push_back(it->second);
+                ++it;
+            }
+        }
+        _dates.swap(dates);
+        _rates.swap(rates);
+        _unordered.clear();
+    }
+    index.assign(_dates, _rates);
+}
+
+std::size_t RateIndexBuilder::size() const {
+    return _dates.size() + _unordered.size();
+}
+
+namespace {
+std::size_t rates_offset(std::size_t n) {
+    const std::size_t end_of_dates = header_size + n * sizeof(int32_t);
+    return (end_of_dates + sizeof(double) - 1)
+        / sizeof(double) * sizeof(double);
+}
+}  // namespace
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// Read-only as-of index over an exchange rate history.
+// Dates (serial numbers) and rates are kept in two parallel contiguous arrays
+// sorted by date, so a lookup touches only the date array and one rate.
+// The two arrays can also be saved to and restored from a binary snapshot
+// (a small header, the dates, the rates and a checksum), which skips the CSV
+// parsing and validation done by BitcoinExchange::load_data.
+class RateIndex {
+ public:
+    RateIndex();
+    RateIndex(const RateIndex &other);
+    RateIndex &operator=(const RateIndex &other);
+    ~RateIndex();
+
+    void assign(std::vector<int> &dates, std::vector<double> &rates);
+    void swap(RateIndex &other);
+    void clear();
+
+    bool find(int serial_date, double &rate) const;
+    std::size_t upper_bound(int serial_date) const;
+    static std::size_t upper_bound(const int *dates, std::size_t size,
+        int serial_date);
+    std::size_t upper_bound_from(std::size_t hint, int serial_date) const;
+
+    std::size_t size() const;
+    bool empty() const;
+    const int *dates() const;
+    const double *rates() const;
+
+    void write_snapshot(const std::string &filename) const;
+    void read_snapshot(const std::string &filename);
+
+ private:
+    std::vector<int> _dates;
+    std::vector<double> _rates;
+};
+
+// Collects (date, rate) rows in file order and turns them into a RateIndex.
+// Rows that arrive in date order are appended to the sorted arrays directly;
+// only out-of-order rows are parked in a map until build() merges them.
+class RateIndexBuilder {
+ public:
+    RateIndexBuilder();
+    RateIndexBuilder(const RateIndexBuilder &other);
+    RateIndexBuilder &operator=(const RateIndexBuilder &other);
+    ~RateIndexBuilder();
+
+    void assign(const RateIndex &index);
+    bool insert(int serial_date, double rate);
+    void build(RateIndex &index);
+
+    std::size_t size() const;
+
+ private:
+    std::vector<int> _dates;
+    std::vector<double> _rates;
+    std::map<int, double> _unordered;
+};
@@ -0,0 +1,210 @@
+#include <ex00/RateStream.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <ex00/BasicDate.hpp>
+#include <ex00/calendar_system/GregorianCalendar.hpp>
+#include <toolbox/string.hpp>
+#include <toolbox/StepMark.hpp>
+
+namespace {
+typedef toolbox::BasicDate<toolbox::GregorianCalendar> GregorianDate;
+
+const toolbox::DateFormat date_format("%Y-%m-%d");
+}  // namespace
+
+RateStream::RateStream()
+    : _file(), _line(), _report(false), _sorted(true), _has_last(false),
+    _last_date(0), _position(0) {}
+
+RateStream::~RateStream() {}
+
+/*
+ * @brief Opens filename and reads its header line.
+ * @param report Whether to warn about the file, its header and its rows
+ *        (on std::cerr and in the log), with the messages load_data uses.
+ * @return false if the file cannot be opened. An empty file opens fine and
+ *         simply has no rows.
+ */
+bool RateStream::open(const std::string &filename, bool report) {
+    close();
+    _report = report;
+    _file.open(filename.c_str());
+    if (!_file.is_open()) {
+        if (_report) {
+            std::cerr << "Warning: failed to open data file: " << filename
+                << " (the database will be empty)" << std::endl;
+            toolbox::logger::StepMark::warning(std::string(
+                "Failed to open data file: ") + filename);
+        }
+        return false;
+    }
+    if (!std::getline(_file, _line)) {
+        if (_report) {
+            std::cerr << "Warning: data file is empty: " << filename
+                << " (the database will be empty)" << std::endl;
+            toolbox::logger::StepMark::warning(std::string(
+                "Data file is empty: ") + filename);
+        }
+        return true;
+    }
+    _position += _line.size() + 1;
+    if (_report && _line != "date,exchange_rate") {
+        std::cerr << "Warning: invalid header in data file: " << filename
+            << "(Expecting 'date,exchange_rate')" << std::endl;
+        toolbox::logger::StepMark::warning(std::string(
+            "Invalid header detected in data file: ") + filename);
+    }
+    return true;
+}
+
+void RateStream::close() {
+    if (_file.is_open()) {
+        _file.close();
+    }
+    _file.clear();
+    _sorted = true;
+    _has_last = false;
+    _last_date = 0;
+    _position = 0;
+}
+
+/*
+ * @brief Reads the next valid row, skipping (and reporting) malformed ones.
+ * @return false at the end of the file, or at a row dated before the
+ *         previous one; that row is left unread (position() stays before
+ *         it) and sorted() becomes false.
+ * @note [complexity]: O(length of the lines read)
+ */
+bool RateStream::next(int &serial_date, double &rate) {
+    if (!_sorted) {
+        return false;
+    }
+    while (std::getline(_file, _line)) {
+        const char *line_begin = _line.data();
+        const char *line_end = line_begin + _line.size();
+        const std::size_t line_start = _position;
+        _position += _line.size() + 1;
+        int date;
+        double value;
+        if (!parse_rate_row(line_begin, line_end, date, value, _report)) {
+            continue;
+        }
+        if (_has_last && date < _last_date) {
+            _sorted = false;
+            _position = line_start;
+            return false;
+        }
+        if (_has_last && date == _last_date && _report) {
+            report_duplicate_rate(line_begin, line_end);
+        }
+        _has_last = true;
+        _last_date = date;
+        serial_date = date;
+        rate = value;
+        return true;
+    }
+    return false;
+}
+
+// false once a row dated before the previous one has been met.
+bool RateStream::sorted() const {
+    return _sorted;
+}
+
+// Bytes of the file (header included) whose rows have been read.
+std::size_t RateStream::position() const {
+    return _position;
+}
+
+/*
+ * @brief Parses one "date,exchange_rate" row of a data file.
+ * @param report Whether to warn about (and log) a row that is rejected.
+ * @return false if the row is malformed, its date invalid or its rate not
+ *         a non-negative number.
+ */
+bool parse_rate_row(const char *line_begin, const char *line_end,
+    int &serial_date, double &rate, bool report) {
+    const char *delimiter = static_cast<const char *>(
+        std::memchr(line_begin, ',', line_end - line_begin));
+    if (delimiter == NULL) {
+        if (report) {
+            const std::string line(line_begin, line_end);
+            std::cerr << "Warning: invalid line format "
+                << "(missing delimiter) in data file: "
+                << line << "(this line will be ignored)" << std::endl;
+            toolbox::logger::StepMark::warning(std::string(
+                "Ignoring malformed line (missing delimiter): ") + line);
+        }
+        return false;
+    }
+    if (delimiter == line_begin || delimiter + 1 == line_end) {
+        if (report) {
+            const std::string line(line_begin, line_end);
+            std::cerr << "Warning: invalid line format "
+                << "(empty date or value) in data file: "
+                << line << "(this line will be ignored)" << std::endl;
+            toolbox::logger::StepMark::warning(std::string(
+                "Ignoring malformed line (empty date or value): ") + line);
+        }
+        return false;
+    }
+    // A "YYYY-MM-DD" date is parsed in place; other shapes (such as years of
+    // more than 4 digits) go through the generic parser.
+    int date = 0;
+    toolbox::ParseResult parsed;
+    if (!toolbox::GregorianCalendar::parse_iso_date(line_begin,
+            delimiter - line_begin, parsed, date)) {
+        GregorianDate generic;
+        parsed = generic.parse(std::string(line_begin, delimiter),
+            date_format, true);
+        date = generic.get_raw_date();
+    }
+    double value;
+    std::string error;
+    if (parsed.status != toolbox::ParseResult::OK) {
+        error = parsed.message;
+    } else if (!toolbox::parse_double(delimiter + 1,
+            line_end - (delimiter + 1), value)) {
+        error = "Invalid double: '" + std::string(delimiter + 1, line_end)
+            + "'";
+    }
+    if (!error.empty()) {
+        if (report) {
+            const std::string line(line_begin, line_end);
+            std::cerr << "Warning: invalid data in line: " << line
+                << " (" << error << ") (this line will be ignored)"
+                << std::endl;
+            toolbox::logger::StepMark::warning("Ignoring invalid data line: "
+                + line + " (" + error + ")");
+        }
+        return false;
+    }
+    if (value < 0.0) {
+        if (report) {
+            const std::string line(line_begin, line_end);
+            std::cerr << "Warning: negative exchange rate in line: "
+                << line << " (this line will be ignored)" << std::endl;
+            toolbox::logger::StepMark::warning(std::string(
+                "Ignoring negative exchange rate: ") + line);
+        }
+        return false;
+    }
+    serial_date = date;
+    rate = value;
+    return true;
+}
+
+// Reports a row whose date was already given a rate earlier in the file.
+void report_duplicate_rate(const char *line_begin, const char *line_end) {
+    const std::string line(line_begin, line_end);
+    std::cerr << "Warning: duplicate date entry in data file: "
+        << line << " (the rate for this date will be overwritten)"
+        << std::endl;
+    toolbox::logger::StepMark::notice(std::string(
+        "Duplicate date detected, overwriting entry: ") + line);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+// Reads an exchange rate data file ("date,exchange_rate" rows) one row at a
+// time, validating the rows the way BitcoinExchange::load_data does, so that
+// a history can be walked in file order without being held in memory.
+//
+// The stream only moves forward in date: it stops at the first row dated
+// before the previous one (sorted() then turns false). Rows sharing a date
+// are all returned, the last one being the one in effect.
+class RateStream {
+ public:
+    RateStream();
+    ~RateStream();
+
+    bool open(const std::string &filename, bool report);
+    void close();
+    bool next(int &serial_date, double &rate);
+
+    bool sorted() const;
+    std::size_t position() const;
+
+ private:
+    RateStream(const RateStream &other);
+    RateStream &operator=(const RateStream &other);
+
+    std::ifstream _file;
+    std::string _line;
+    bool _report;  // warn about (and log) malformed and duplicate rows
+    bool _sorted;
+    bool _has_last;
+    int _last_date;
+    std::size_t _position;  // bytes of the file consumed so far
+};
+
+bool parse_rate_row(const char *line_begin, const char *line_end,
+    int &serial_date, double &rate, bool report);
+void report_duplicate_rate(const char *line_begin, const char *line_end);
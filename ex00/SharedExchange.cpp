@@ -0,0 +1,217 @@
+#include <ex00/SharedExchange.hpp>
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <ex00/BitcoinExchange.hpp>
+
+namespace {
+// Sequentially consistent atomics (GCC / Clang builtins); C++98 has none.
+template <typename T>
+T atomic_load(const T *p) {
+    return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+}
+
+template <typename T>
+void atomic_store(T *p, T value) {
+    __atomic_store_n(p, value, __ATOMIC_SEQ_CST);
+}
+
+template <typename T>
+T atomic_exchange(T *p, T value) {
+    return __atomic_exchange_n(p, value, __ATOMIC_SEQ_CST);
+}
+
+class ScopedLock {
+ public:
+    explicit ScopedLock(pthread_mutex_t &mutex) : _mutex(mutex) {
+        ::pthread_mutex_lock(&_mutex);
+    }
+    ~ScopedLock() {
+        ::pthread_mutex_unlock(&_mutex);
+    }
+
+ private:
+    ScopedLock(const ScopedLock &other);
+    ScopedLock &operator=(const ScopedLock &other);
+
+    pthread_mutex_t &_mutex;
+};
+}  // namespace
+
+const std::size_t SharedExchange::DEFAULT_MAX_READERS;
+const std::size_t SharedExchange::CACHE_LINE_SIZE;
+
+/*
+ * @brief Starts with an empty exchange as version 0.
+ * @param max_readers The number of Readers that can exist at the same time.
+ */
+SharedExchange::SharedExchange(std::size_t max_readers)
+    : _current(NULL), _current_version(0), _epoch(1), _slot_storage(NULL),
+    _slots(NULL), _slot_count(max_readers), _retired(), _last_version(0) {
+    _slot_storage = new char[(_slot_count + 1) * CACHE_LINE_SIZE];
+    const uintptr_t address = reinterpret_cast<uintptr_t>(_slot_storage);
+    _slots = reinterpret_cast<ReaderSlot *>((address + CACHE_LINE_SIZE - 1)
+        & ~static_cast<uintptr_t>(CACHE_LINE_SIZE - 1));
+    for (std::size_t i = 0; i < _slot_count; ++i) {
+        _slots[i].epoch = 0;
+        _slots[i].in_use = 0;
+    }
+    try {
+        _current = new Snapshot();
+    } catch (...) {
+        delete[] _slot_storage;
+        throw;
+    }
+    _current->version = 0;
+    ::pthread_mutex_init(&_writer_mutex, NULL);
+}
+
+/*
+ * @note [constraint]: no Reader of this object is left
+ */
+SharedExchange::~SharedExchange() {
+    for (std::size_t i = 0; i < _retired.size(); ++i) {
+        delete _retired[i].snapshot;
+    }
+    delete _current;
+    delete[] _slot_storage;
+    ::pthread_mutex_destroy(&_writer_mutex);
+}
+
+/*
+ * @brief Makes a copy of exchange the current snapshot.
+ * @return The version number of the new snapshot (1, 2, ...).
+ * @note Readers that pinned the previous snapshot keep using it; it is
+ *       deleted by a later publish or reclaim once all of them let go.
+ */
+uint64_t SharedExchange::publish(const BitcoinExchange &exchange) {
+    Snapshot *snapshot = new Snapshot();
+    try {
+        snapshot->exchange = exchange;
+    } catch (...) {
+        delete snapshot;
+        throw;
+    }
+    ScopedLock lock(_writer_mutex);
+    try {
+        _retired.reserve(_retired.size() + 1);
+    } catch (...) {
+        delete snapshot;
+        throw;
+    }
+    snapshot->version = ++_last_version;
+    Retired retired;
+    retired.snapshot = atomic_exchange(&_current, snapshot);
+    atomic_store(&_current_version, snapshot->version);
+    // A reader that pins from now on reads an epoch >= this one, and thus
+    // the new snapshot.
+    retired.epoch = __atomic_add_fetch(&_epoch, 1, __ATOMIC_SEQ_CST);
+    _retired.push_back(retired);
+    reclaim_locked();
+    return snapshot->version;
+}
+
+/*
+ * @brief Deletes the retired snapshots that no reader can still be using.
+ * @return The number of retired snapshots still waiting for readers.
+ */
+std::size_t SharedExchange::reclaim() {
+    ScopedLock lock(_writer_mutex);
+    return reclaim_locked();
+}
+
+// The version of the current snapshot. Reads a copy of it rather than
+// _current, which may be deleted under an unpinned reader.
+uint64_t SharedExchange::version() const {
+    return atomic_load(&_current_version);
+}
+
+// A snapshot retired at epoch E can only be pinned by a reader whose slot
+// holds an epoch below E.
+std::size_t SharedExchange::reclaim_locked() {
+    uint64_t oldest_pin = 0;
+    for (std::size_t i = 0; i < _slot_count; ++i) {
+        const uint64_t epoch = atomic_load(&_slots[i].epoch);
+        if (epoch != 0 && (oldest_pin == 0 || epoch < oldest_pin)) {
+            oldest_pin = epoch;
+        }
+    }
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < _retired.size(); ++i) {
+        if (oldest_pin == 0 || _retired[i].epoch <= oldest_pin) {
+            delete _retired[i].snapshot;
+        } else {
+            _retired[kept++] = _retired[i];
+        }
+    }
+    _retired.resize(kept);
+    return kept;
+}
+
+/*
+ * @brief Claims a reader slot of shared.
+ * @throw std::runtime_error if all slots are taken.
+ */
+SharedExchange::Reader::Reader(SharedExchange &shared)
+    : _shared(shared), _slot(0), _pinned(NULL) {
+    for (; _slot < _shared._slot_count; ++_slot) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&_shared._slots[_slot].in_use,
+                &expected, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            return;
+        }
+    }
+    throw std::runtime_error("SharedExchange::Reader: no free reader slot");
+}
+
+SharedExchange::Reader::~Reader() {
+    unlock();
+    atomic_store(&_shared._slots[_slot].in_use, 0);
+}
+
+/*
+ * @brief Pins the current snapshot (or returns the one already pinned).
+ * @note Wait-free: no lock, no retry loop.
+ */
+const BitcoinExchange &SharedExchange::Reader::lock() {
+    if (_pinned == NULL) {
+        atomic_store(&_shared._slots[_slot].epoch,
+            atomic_load(&_shared._epoch));
+        _pinned = atomic_load(&_shared._current);
+    }
+    return _pinned->exchange;
+}
+
+// Lets go of the pinned snapshot, which may be deleted from then on.
+void SharedExchange::Reader::unlock() {
+    if (_pinned != NULL) {
+        _pinned = NULL;
+        atomic_store(&_shared._slots[_slot].epoch,
+            static_cast<uint64_t>(0));
+    }
+}
+
+// The version of the pinned snapshot (the current one if none is pinned).
+uint64_t SharedExchange::Reader::version() const {
+    return _pinned ? _pinned->version : _shared.version();
+}
+
+SharedExchange::ReadGuard::ReadGuard(Reader &reader)
+    : _reader(reader), _exchange(&reader.lock()) {}
+
+SharedExchange::ReadGuard::~ReadGuard() {
+    _reader.unlock();
+}
+
+const BitcoinExchange &SharedExchange::ReadGuard::operator*() const {
+    return *_exchange;
+}
+
+const BitcoinExchange *SharedExchange::ReadGuard::operator->() const {
+    return _exchange;
+}
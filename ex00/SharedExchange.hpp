@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include <cstddef>
+#include <vector>
+
+#include <ex00/BitcoinExchange.hpp>
+
+// Publishes immutable, versioned snapshots of a BitcoinExchange to reader
+// threads without making them take a lock (epoch-based reclamation, in the
+// spirit of RCU).
+//
+// Every reading thread owns a Reader, which holds one of a fixed number of
+// slots. Pinning a snapshot is two atomic stores and loads; the writer
+// (publish) swaps in a new snapshot and only deletes an old one once no
+// slot can still be pinning it. Writers are serialized by a mutex.
+//
+//     SharedExchange shared;
+//     shared.publish(exchange);                  // writer, after a reload
+//     SharedExchange::Reader reader(shared);     // once per reader thread
+//     {
+//         SharedExchange::ReadGuard guard(reader);
+//         double rate = guard->get_exchange_rate(date);
+//     }
+class SharedExchange {
+ private:
+    struct Snapshot {
+        BitcoinExchange exchange;
+        uint64_t version;
+    };
+
+ public:
+    static const std::size_t DEFAULT_MAX_READERS = 64;
+
+    // A reading thread's handle. Not to be shared between threads.
+    class Reader {
+     public:
+        explicit Reader(SharedExchange &shared);
+        ~Reader();
+
+        const BitcoinExchange &lock();
+        void unlock();
+        uint64_t version() const;
+
+     private:
+        Reader(const Reader &other);
+        Reader &operator=(const Reader &other);
+
+        SharedExchange &_shared;
+        std::size_t _slot;
+        const Snapshot *_pinned;
+    };
+
+    // Keeps the current snapshot pinned for the lifetime of the guard.
+    class ReadGuard {
+     public:
+        explicit ReadGuard(Reader &reader);
+        ~ReadGuard();
+
+        const BitcoinExchange &operator*() const;
+        const BitcoinExchange *operator->() const;
+
+     private:
+        ReadGuard(const ReadGuard &other);
+        ReadGuard &operator=(const ReadGuard &other);
+
+        Reader &_reader;
+        const BitcoinExchange *_exchange;
+    };
+
+    explicit SharedExchange(std::size_t max_readers = DEFAULT_MAX_READERS);
+    ~SharedExchange();
+
+    uint64_t publish(const BitcoinExchange &exchange);
+    std::size_t reclaim();
+    uint64_t version() const;
+
+ private:
+    SharedExchange(const SharedExchange &other);
+    SharedExchange &operator=(const SharedExchange &other);
+
+    static const std::size_t CACHE_LINE_SIZE = 64;
+
+    // One cache line each, so that readers pinning at the same time do not
+    // write to the same line.
+    struct ReaderSlot {
+        uint64_t epoch;  // epoch seen when the snapshot was pinned, 0 = idle
+        int in_use;
+        char padding[CACHE_LINE_SIZE - sizeof(uint64_t) - sizeof(int)];
+    };
+
+    struct Retired {
+        Snapshot *snapshot;
+        uint64_t epoch;  // first epoch in which it is no longer current
+    };
+
+    std::size_t reclaim_locked();
+
+    Snapshot *_current;
+    uint64_t _current_version;  // readable without pinning _current
+    uint64_t _epoch;
+    char *_slot_storage;        // holds _slots, aligned to a cache line
+    ReaderSlot *_slots;
+    std::size_t _slot_count;
+    std::vector<Retired> _retired;
+    uint64_t _last_version;
+    pthread_mutex_t _writer_mutex;
+};
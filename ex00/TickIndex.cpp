@@ -0,0 +1,183 @@
+#include <ex00/TickIndex.hpp>
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <ex00/Timestamp.hpp>
+
+namespace {
+// Largest offset a tick can have from the first tick of its group.
+const uint32_t max_offset = 0xFFFF;
+// Ticks are numbered with 32 bits.
+const std::size_t max_ticks = 0xFFFFFFFFu;
+}  // namespace
+
+const std::size_t TickIndex::GROUP_SIZE;
+
+TickIndex::TickIndex()
+    : _days(), _day_groups(), _group_ticks(), _group_bases(), _offsets(),
+    _rates() {}
+
+TickIndex::TickIndex(const TickIndex &other)
+    : _days(other._days), _day_groups(other._day_groups),
+    _group_ticks(other._group_ticks), _group_bases(other._group_bases),
+    _offsets(other._offsets), _rates(other._rates) {}
+
+TickIndex &TickIndex::operator=(const TickIndex &other) {
+    if (this != &other) {
+        _days = other._days;
+        _day_groups = other._day_groups;
+        _group_ticks = other._group_ticks;
+        _group_bases = other._group_bases;
+        _offsets = other._offsets;
+        _rates = other._rates;
+    }
+    return *this;
+}
+
+TickIndex::~TickIndex() {}
+
+/*
+ * @brief Adds the rate in effect from time on.
+ * @return false (and leaves the index unchanged) if time is before the last
+ *         tick; ticks must be appended in time order. A tick at the time of
+ *         the last one replaces its rate.
+ * @throw std::length_error past 2^32 - 1 ticks.
+ * @note [complexity]: amortized O(1)
+ */
+bool TickIndex::append(int64_t time, double rate) {
+    if (!_rates.empty()) {
+        const int64_t last = last_time();
+        if (time < last) {
+            return false;
+        }
+        if (time == last) {
+            _rates.back() = rate;
+            return true;
+        }
+    }
+    if (_rates.size() >= max_ticks) {
+        throw std::length_error("TickIndex::append failed: too many ticks");
+    }
+    const int day = toolbox::Timestamp::day_of(time);
+    const uint32_t time_of_day = static_cast<uint32_t>(
+        time - toolbox::Timestamp::day_start(day));
+    const bool new_day = _days.empty() || _days.back() != day;
+    if (new_day) {
+        _days.push_back(day);
+        _day_groups.push_back(static_cast<uint32_t>(_group_ticks.size()));
+    }
+    if (new_day || _rates.size() - _group_ticks.back() == GROUP_SIZE
+        || time_of_day - _group_bases.back() > max_offset) {
+        _group_ticks.push_back(static_cast<uint32_t>(_rates.size()));
+        _group_bases.push_back(time_of_day);
+    }
+    _offsets.push_back(static_cast<uint16_t>(
+        time_of_day - _group_bases.back()));
+    _rates.push_back(rate);
+    return true;
+}
+
+// Makes room for ticks ticks in total, so that appending them all does not
+// reallocate the per-tick arrays.
+void TickIndex::reserve(std::size_t ticks) {
+    _offsets.reserve(ticks);
+    _rates.reserve(ticks);
+    _group_ticks.reserve(ticks / GROUP_SIZE + 1);
+    _group_bases.reserve(ticks / GROUP_SIZE + 1);
+}
+
+void TickIndex::swap(TickIndex &other) {
+    _days.swap(other._days);
+    _day_groups.swap(other._day_groups);
+    _group_ticks.swap(other._group_ticks);
+    _group_bases.swap(other._group_bases);
+    _offsets.swap(other._offsets);
+    _rates.swap(other._rates);
+}
+
+void TickIndex::clear() {
+    TickIndex().swap(*this);
+}
+
+/*
+ * @brief Looks up the rate in effect at time: the rate of the last tick at
+ *        or before it.
+ * @return false if time is before the first tick.
+ * @note [complexity]: O(log d + log g + GROUP_SIZE) for d days and g
+ *       groups in the day of time
+ */
+bool TickIndex::find(int64_t time, double &rate) const {
+    if (_rates.empty() || time < first_time()) {
+        return false;
+    }
+    if (time >= last_time()) {
+        rate = _rates.back();
+        return true;
+    }
+    const int day = toolbox::Timestamp::day_of(time);
+    const std::size_t d = std::upper_bound(_days.begin(), _days.end(), day)
+        - _days.begin() - 1;
+    if (_days[d] < day) {
+        // No tick that day: the last tick of day d is in effect.
+        rate = _rates[_group_ticks[_day_groups[d + 1]] - 1];
+        return true;
+    }
+    const uint32_t time_of_day = static_cast<uint32_t>(
+        time - toolbox::Timestamp::day_start(day));
+    const std::size_t first_group = _day_groups[d];
+    const std::size_t end_group = (d + 1 < _days.size())
+        ? _day_groups[d + 1] : _group_ticks.size();
+    const std::size_t group = std::upper_bound(
+        _group_bases.begin() + first_group, _group_bases.begin() + end_group,
+        time_of_day) - _group_bases.begin();
+    if (group == first_group) {
+        // Before the first tick of the day: the previous tick is in effect.
+        rate = _rates[_group_ticks[first_group] - 1];
+        return true;
+    }
+    const uint32_t offset = time_of_day - _group_bases[group - 1];
+    std::size_t tick = _group_ticks[group - 1];
+    const std::size_t end = group_end(group - 1);
+    while (tick + 1 < end && _offsets[tick + 1] <= offset) {
+        ++tick;
+    }
+    rate = _rates[tick];
+    return true;
+}
+
+std::size_t TickIndex::size() const {
+    return _rates.size();
+}
+
+bool TickIndex::empty() const {
+    return _rates.empty();
+}
+
+// Time of the first tick (0 if the index is empty).
+int64_t TickIndex::first_time() const {
+    if (_rates.empty()) {
+        return 0;
+    }
+    return toolbox::Timestamp::day_start(_days.front())
+        + _group_bases.front();
+}
+
+// Time of the last tick (0 if the index is empty).
+int64_t TickIndex::last_time() const {
+    if (_rates.empty()) {
+        return 0;
+    }
+    return toolbox::Timestamp::day_start(_days.back()) + _group_bases.back()
+        + _offsets.back();
+}
+
+// One past the last tick of group.
+std::size_t TickIndex::group_end(std::size_t group) const {
+    return (group + 1 < _group_ticks.size())
+        ? _group_ticks[group + 1] : _rates.size();
+}
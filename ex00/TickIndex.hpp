@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <vector>
+
+// Read-only as-of index over a tick-level rate history (one rate per second
+// at most), laid out by day so that 10^8 ticks stay compact:
+// - every day that has ticks has an entry (its serial date, first group),
+// - the ticks of a day are cut into groups of at most GROUP_SIZE, each
+//   holding the time of day of its first tick,
+// - every tick only stores its offset from the first tick of its group (16
+//   bits; a group is also closed before an offset would overflow) and its
+//   rate.
+// That is about 10 bytes per tick. A lookup is a binary search over the
+// days, another over the groups of one day and a scan of at most
+// GROUP_SIZE offsets, whatever the size of the history.
+//
+// Times are seconds since the epoch (see toolbox::Timestamp).
+class TickIndex {
+ public:
+    static const std::size_t GROUP_SIZE = 32;
+
+    TickIndex();
+    TickIndex(const TickIndex &other);
+    TickIndex &operator=(const TickIndex &other);
+    ~TickIndex();
+
+    bool append(int64_t time, double rate);
+    void reserve(std::size_t ticks);
+    void swap(TickIndex &other);
+    void clear();
+
+    bool find(int64_t time, double &rate) const;
+
+    std::size_t size() const;
+    bool empty() const;
+    int64_t first_time() const;
+    int64_t last_time() const;
+
+ private:
+    std::size_t group_end(std::size_t group) const;
+
+    std::vector<int> _days;              // serial dates with ticks
+    std::vector<uint32_t> _day_groups;   // first group of each day
+    std::vector<uint32_t> _group_ticks;  // first tick of each group
+    std::vector<uint32_t> _group_bases;  // its time of day, in seconds
+    std::vector<uint16_t> _offsets;      // tick time - group base
+    std::vector<double> _rates;
+};
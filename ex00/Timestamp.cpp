@@ -0,0 +1,220 @@
+#include <ex00/Timestamp.hpp>
+
+#include <stdint.h>
+
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+#include <ex00/Date.hpp>
+#include <ex00/calendar_system/DateBuffer.hpp>
+
+namespace {
+// Length of " HH:MM:SS", the separator included.
+const std::size_t time_of_day_size = 9;
+
+const toolbox::ParseResult bad_time_of_day = {
+    toolbox::ParseResult::NO_MATCH,
+    "Timestamp::parse failed: time of day is not HH:MM:SS"
+};
+
+bool parse_two_digits(const char* s, int max, int& value);
+}  // namespace
+
+const int toolbox::Timestamp::SECONDS_PER_DAY;
+
+toolbox::Timestamp::Timestamp() : _seconds(0) {}
+
+toolbox::Timestamp::Timestamp(const Timestamp& other)
+    : _seconds(other._seconds) {}
+
+toolbox::Timestamp& toolbox::Timestamp::operator=(const Timestamp& other) {
+    if (this != &other) {
+        _seconds = other._seconds;
+    }
+    return *this;
+}
+
+toolbox::Timestamp::~Timestamp() {}
+
+toolbox::Timestamp::Timestamp(int64_t seconds) : _seconds(seconds) {}
+
+/*
+ * @throw std::out_of_range if the time of day is not within 00:00:00 and
+ *        23:59:59.
+ */
+toolbox::Timestamp::Timestamp(const Date& date, int hour, int minute,
+        int second)
+    : _seconds(0) {
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59
+        || second < 0 || second > 59) {
+        throw std::out_of_range(
+            "Timestamp::Timestamp failed: time of day out of range");
+    }
+    _seconds = day_start(date.get_raw_date())
+        + hour * 3600 + minute * 60 + second;
+}
+
+/*
+ * @throw std::invalid_argument if time_str does not parse (see parse).
+ */
+toolbox::Timestamp::Timestamp(CalendarSystem cal_sys,
+        const std::string& time_str, const DateFormat& date_format,
+        bool strict)
+    : _seconds(0) {
+    const ParseResult result = parse(cal_sys, time_str, date_format, strict);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
+    }
+}
+
+/*
+ * @brief Reads "<date> HH:MM:SS" (or "<date>THH:MM:SS"), the date being
+ *        parsed like Date::parse does with date_format.
+ * @return The outcome; the timestamp is left unchanged unless it is OK.
+ * @note The time of day is the last 8 characters, each field exactly two
+ *       digits, so a date format may itself contain spaces.
+ */
+toolbox::ParseResult toolbox::Timestamp::parse(CalendarSystem cal_sys,
+        const std::string& time_str, const DateFormat& date_format,
+        bool strict) {
+    if (time_str.size() <= time_of_day_size) {
+        return bad_time_of_day;
+    }
+    const std::size_t date_size = time_str.size() - time_of_day_size;
+    const char* time = time_str.data() + date_size;
+    int hour, minute, second;
+    if ((time[0] != ' ' && time[0] != 'T')
+        || !parse_two_digits(time + 1, 23, hour) || time[3] != ':'
+        || !parse_two_digits(time + 4, 59, minute) || time[6] != ':'
+        || !parse_two_digits(time + 7, 59, second)) {
+        return bad_time_of_day;
+    }
+    Date date;
+    const ParseResult result = date.parse(cal_sys,
+        time_str.substr(0, date_size), date_format, strict);
+    if (result.status == ParseResult::OK) {
+        _seconds = day_start(date.get_raw_date())
+            + hour * 3600 + minute * 60 + second;
+    }
+    return result;
+}
+
+std::string toolbox::Timestamp::to_string(CalendarSystem cal_sys,
+        const char* date_format) const {
+    std::string time_str = get_date().to_string(cal_sys, date_format);
+    char buffer[time_of_day_size + 1];
+    DateBuffer out(buffer, sizeof(buffer));
+    out.append(' ');
+    out.append_number(get_hour(), 2);
+    out.append(':');
+    out.append_number(get_minute(), 2);
+    out.append(':');
+    out.append_number(get_second(), 2);
+    time_str.append(out.data(), out.size());
+    return time_str;
+}
+
+int64_t toolbox::Timestamp::get_raw_time() const {
+    return _seconds;
+}
+
+toolbox::Date toolbox::Timestamp::get_date() const {
+    return Date(day_of(_seconds));
+}
+
+// Seconds since midnight, in [0, SECONDS_PER_DAY).
+int toolbox::Timestamp::get_seconds_of_day() const {
+    return static_cast<int>(_seconds - day_start(day_of(_seconds)));
+}
+
+int toolbox::Timestamp::get_hour() const {
+    return get_seconds_of_day() / 3600;
+}
+
+int toolbox::Timestamp::get_minute() const {
+    return get_seconds_of_day() / 60 % 60;
+}
+
+int toolbox::Timestamp::get_second() const {
+    return get_seconds_of_day() % 60;
+}
+
+toolbox::Timestamp toolbox::Timestamp::operator+(int64_t delta) const {
+    return Timestamp(_seconds + delta);
+}
+
+toolbox::Timestamp toolbox::Timestamp::operator-(int64_t delta) const {
+    return Timestamp(_seconds - delta);
+}
+
+int64_t toolbox::Timestamp::operator-(const Timestamp& other) const {
+    return _seconds - other._seconds;
+}
+
+toolbox::Timestamp& toolbox::Timestamp::operator+=(int64_t delta) {
+    _seconds += delta;
+    return *this;
+}
+
+toolbox::Timestamp& toolbox::Timestamp::operator-=(int64_t delta) {
+    _seconds -= delta;
+    return *this;
+}
+
+bool toolbox::Timestamp::operator==(const Timestamp& other) const {
+    return _seconds == other._seconds;
+}
+
+bool toolbox::Timestamp::operator!=(const Timestamp& other) const {
+    return _seconds != other._seconds;
+}
+
+bool toolbox::Timestamp::operator<(const Timestamp& other) const {
+    return _seconds < other._seconds;
+}
+
+bool toolbox::Timestamp::operator<=(const Timestamp& other) const {
+    return _seconds <= other._seconds;
+}
+
+bool toolbox::Timestamp::operator>(const Timestamp& other) const {
+    return _seconds > other._seconds;
+}
+
+bool toolbox::Timestamp::operator>=(const Timestamp& other) const {
+    return _seconds >= other._seconds;
+}
+
+// First second of the day serial_date.
+int64_t toolbox::Timestamp::day_start(int serial_date) {
+    return static_cast<int64_t>(serial_date) * SECONDS_PER_DAY;
+}
+
+/*
+ * @brief Serial date of the day containing seconds (rounding down, also
+ *        before the epoch).
+ * @throw std::out_of_range if that day does not fit a serial date (an int).
+ */
+int toolbox::Timestamp::day_of(int64_t seconds) {
+    int64_t day = seconds / SECONDS_PER_DAY;
+    if (seconds % SECONDS_PER_DAY < 0) {
+        --day;
+    }
+    if (day < INT_MIN || day > INT_MAX) {
+        throw std::out_of_range(
+            "Timestamp::day_of failed: date out of range");
+    }
+    return static_cast<int>(day);
+}
+
+namespace {
+// Reads exactly two decimal digits, not greater than max.
+bool parse_two_digits(const char* s, int max, int& value) {
+    if (s[0] < '0' || s[0] > '9' || s[1] < '0' || s[1] > '9') {
+        return false;
+    }
+    value = (s[0] - '0') * 10 + (s[1] - '0');
+    return value <= max;
+}
+}  // namespace
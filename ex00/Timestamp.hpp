@@ -0,0 +1,75 @@
+/**
+ * @file Timestamp.hpp
+ * @brief Defines the Timestamp class, a point in time with a resolution of
+ * one second.
+ *
+ * A Timestamp is a 64-bit count of seconds since 1970-01-01 00:00:00 (the
+ * Unix epoch, without leap seconds and without time zone). Its date part is
+ * a Date (serial day number), so it is read and written in any of the
+ * calendar systems Date supports; the time of day is always "HH:MM:SS".
+ *
+ * The text form is "<date> HH:MM:SS" (or "<date>THH:MM:SS"), the date being
+ * written with the given calendar and format.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+
+#include <ex00/Date.hpp>
+#include <ex00/calendar_system/CalendarSystem.hpp>
+#include <ex00/calendar_system/DateFormat.hpp>
+#include <ex00/calendar_system/ICalendarSystem.hpp>
+
+namespace toolbox {
+
+class Timestamp {
+ public:
+    static const int SECONDS_PER_DAY = 86400;
+
+    Timestamp();
+    Timestamp(const Timestamp& other);
+    Timestamp& operator=(const Timestamp& other);
+    ~Timestamp();
+
+    explicit Timestamp(int64_t seconds);
+    Timestamp(const Date& date, int hour = 0, int minute = 0,
+        int second = 0);
+    Timestamp(CalendarSystem cal_sys, const std::string& time_str,
+        const DateFormat& date_format, bool strict = true);
+
+    ParseResult parse(CalendarSystem cal_sys, const std::string& time_str,
+        const DateFormat& date_format, bool strict = true);
+
+    std::string to_string(CalendarSystem cal_sys,
+        const char* date_format = "%Y-%m-%d") const;
+
+    int64_t get_raw_time() const;
+    Date get_date() const;
+    int get_seconds_of_day() const;
+    int get_hour() const;
+    int get_minute() const;
+    int get_second() const;
+
+    Timestamp operator+(int64_t delta) const;
+    Timestamp operator-(int64_t delta) const;
+    int64_t operator-(const Timestamp& other) const;
+    Timestamp& operator+=(int64_t delta);
+    Timestamp& operator-=(int64_t delta);
+
+    bool operator==(const Timestamp& other) const;
+    bool operator!=(const Timestamp& other) const;
+    bool operator<(const Timestamp& other) const;
+    bool operator<=(const Timestamp& other) const;
+    bool operator>(const Timestamp& other) const;
+    bool operator>=(const Timestamp& other) const;
+
+    static int64_t day_start(int serial_date);
+    static int day_of(int64_t seconds);
+
+ private:
+    int64_t _seconds;  // 0 means 1970-01-01 00:00:00
+};
+
+}  // namespace toolbox
@@ -0,0 +1,42 @@
+#include <ex00/calendar_system/DateBuffer.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace toolbox {
+
+DateBuffer::DateBuffer() : _buffer(NULL), _capacity(0), _size(0) {
+}
+
+DateBuffer::DateBuffer(const DateBuffer& other)
+    : _buffer(other._buffer), _capacity(other._capacity),
+    _size(other._size) {
+}
+
+DateBuffer& DateBuffer::operator=(const DateBuffer& other) {
+    if (this != &other) {
+        _buffer = other._buffer;
+        _capacity = other._capacity;
+        _size = other._size;
+    }
+    return *this;
+}
+
+DateBuffer::~DateBuffer() {
+}
+
+/*
+ * @brief Writes into buffer[0, size), starting with an empty text.
+ * @throw std::invalid_argument if buffer is null or size is 0 (no room for
+ *        the terminating '\0').
+ */
+DateBuffer::DateBuffer(char* buffer, std::size_t size)
+    : _buffer(buffer), _capacity(size - 1), _size(0) {
+    if (!buffer || size == 0) {
+        throw std::invalid_argument("DateBuffer::DateBuffer failed: "
+            "buffer is null or empty");
+    }
+    _buffer[0] = '\0';
+}
+
+}  // namespace toolbox
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace toolbox {
+
+// Room for a date of "%Y-%m-%d" and the like (numbers, names and short
+// separators), terminating '\0' included.
+const std::size_t DATE_BUFFER_SIZE = 64;
+
+/**
+ * @brief Appends the fields of a formatted date to a caller-provided char
+ * buffer, without allocating.
+ *
+ * The text is always followed by a '\0', so a buffer of size n holds at most
+ * n - 1 characters; an append that does not fit throws std::length_error and
+ * leaves the buffer as it was. Numbers are written digit by digit, with the
+ * zero padding done by hand rather than through a stream.
+ */
+class DateBuffer {
+ public:
+    DateBuffer();
+    DateBuffer(const DateBuffer& other);
+    DateBuffer& operator=(const DateBuffer& other);
+    ~DateBuffer();
+
+    DateBuffer(char* buffer, std::size_t size);
+
+    void append(char c);
+    void append(const char* str);
+    void append(const std::string& str);
+    void append_number(int value, std::size_t width = 0);
+
+    const char* data() const;
+    std::size_t size() const;
+
+ private:
+    void reserve(std::size_t count) const;
+
+    char* _buffer;
+    std::size_t _capacity;  // characters, the terminating '\0' excluded
+    std::size_t _size;
+};
+
+// The appends are inline: they run for every field of every formatted date.
+
+inline void DateBuffer::reserve(std::size_t count) const {
+    if (!_buffer || count > _capacity - _size) {
+        throw std::length_error("DateBuffer: formatted date does not fit "
+            "in the buffer");
+    }
+}
+
+inline void DateBuffer::append(char c) {
+    reserve(1);
+    _buffer[_size++] = c;
+    _buffer[_size] = '\0';
+}
+
+inline void DateBuffer::append(const char* str) {
+    const std::size_t length = std::strlen(str);
+    reserve(length);
+    std::memcpy(_buffer + _size, str, length + 1);
+    _size += length;
+}
+
+inline void DateBuffer::append(const std::string& str) {
+    reserve(str.size());
+    std::memcpy(_buffer + _size, str.data(), str.size());
+    _size += str.size();
+    _buffer[_size] = '\0';
+}
+
+/*
+ * @brief Appends value in decimal, left-padded with '0' to width digits.
+ * @note A negative value gets its '-' before the padding ("-007").
+ */
+inline void DateBuffer::append_number(int value, std::size_t width) {
+    // Digits of the magnitude, least significant first; unsigned so that
+    // INT_MIN has one too.
+    char digits[16];
+    std::size_t count = 0;
+    unsigned int magnitude = static_cast<unsigned int>(value);
+    if (value < 0) {
+        magnitude = 0u - magnitude;
+    }
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    const std::size_t padding = width > count ? width - count : 0;
+    reserve((value < 0) + padding + count);
+    char* out = _buffer + _size;
+    if (value < 0) {
+        *out++ = '-';
+    }
+    for (std::size_t i = 0; i < padding; ++i) {
+        *out++ = '0';
+    }
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    *out = '\0';
+    _size = static_cast<std::size_t>(out - _buffer);
+}
+
+inline const char* DateBuffer::data() const {
+    return _buffer;
+}
+
+inline std::size_t DateBuffer::size() const {
+    return _size;
+}
+
+}  // namespace toolbox
@@ -0,0 +1,210 @@
+#include <ex00/calendar_system/DateFormat.hpp>
+
+#include <cctype>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace toolbox {
+
+DateFormat::DateFormat()
+    : _format(), _tokens(), _fixed_widths(true), _numeric_layout(false),
+    _fixed_length(0) {
+}
+
+DateFormat::DateFormat(const DateFormat& other)
+    : _format(other._format), _tokens(other._tokens),
+    _fixed_widths(other._fixed_widths),
+    _numeric_layout(other._numeric_layout),
+    _fixed_length(other._fixed_length) {
+}
+
+DateFormat& DateFormat::operator=(const DateFormat& other) {
+    if (this != &other) {
+        _format = other._format;
+        _tokens = other._tokens;
+        _fixed_widths = other._fixed_widths;
+        _numeric_layout = other._numeric_layout;
+        _fixed_length = other._fixed_length;
+    }
+    return *this;
+}
+
+DateFormat::~DateFormat() {
+}
+
+/*
+ * @brief Compiles format into tokens.
+ * @throw std::invalid_argument if format is null or contains a specifier
+ *        other than %E %e %Y %y %M %m %D %d %W %w %%.
+ */
+DateFormat::DateFormat(const char* format)
+    : _format(), _tokens(), _fixed_widths(true), _numeric_layout(false),
+    _fixed_length(0) {
+    if (!format) {
+        throw std::invalid_argument("DateFormat::DateFormat failed: "
+            "format is null");
+    }
+    _format = format;
+    for (std::size_t i = 0; format[i]; ++i) {
+        if (format[i] != '%' || format[i + 1] == '%') {
+            i += (format[i] == '%');
+            if (_tokens.empty() || _tokens.back().field != LITERAL) {
+                Token token;
+                token.field = LITERAL;
+                token.uppercase = false;
+                token.width = 0;
+                _tokens.push_back(token);
+            }
+            _tokens.back().literal += format[i];
+            _tokens.back().width = _tokens.back().literal.size();
+            continue;
+        }
+        Token token;
+        token.uppercase = std::isupper(format[++i]);
+        token.width = 0;
+        switch (format[i]) {
+            case 'E':
+            case 'e':
+                token.field = ERA;
+                break;
+            case 'Y':
+            case 'y':
+                token.field = YEAR;
+                break;
+            case 'M':
+            case 'm':
+                token.field = MONTH;
+                break;
+            case 'D':
+            case 'd':
+                token.field = DAY;
+                break;
+            case 'W':
+            case 'w':
+                token.field = WEEKDAY;
+                break;
+            default:
+                throw std::invalid_argument("DateFormat::DateFormat failed: "
+                    "Invalid format specifier: %"
+                    + (format[i] ? std::string(1, format[i]) : std::string()));
+        }
+        if (!token.uppercase && token.field != ERA
+            && token.field != WEEKDAY) {
+            token.width = 2;
+        }
+        _tokens.push_back(token);
+    }
+
+    int seen[WEEKDAY + 1] = {0};
+    std::size_t variable_fields = 0;
+    for (std::size_t i = 0; i < _tokens.size(); ++i) {
+        ++seen[_tokens[i].field];
+        if (_tokens[i].width == 0) {
+            ++variable_fields;
+        } else {
+            _fixed_length += _tokens[i].width;
+        }
+    }
+    _fixed_widths = (variable_fields == 0);
+    _numeric_layout = seen[YEAR] == 1 && seen[MONTH] == 1 && seen[DAY] == 1
+        && seen[ERA] == 0 && seen[WEEKDAY] == 0 && variable_fields <= 1;
+}
+
+const char* DateFormat::c_str() const {
+    return _format.c_str();
+}
+
+std::size_t DateFormat::size() const {
+    return _tokens.size();
+}
+
+const DateFormat::Token& DateFormat::operator[](std::size_t i) const {
+    return _tokens[i];
+}
+
+bool DateFormat::has_field(Field field, bool uppercase) const {
+    for (std::size_t i = 0; i < _tokens.size(); ++i) {
+        if (_tokens[i].field == field && _tokens[i].uppercase == uppercase) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// true if every field takes a fixed number of characters.
+bool DateFormat::has_fixed_widths() const {
+    return _fixed_widths;
+}
+
+// true if the format is year, month and day (once each) between literals,
+// with at most one variable width field, so that the position of every field
+// in a date string follows from the length of the string alone.
+bool DateFormat::has_numeric_layout() const {
+    return _numeric_layout;
+}
+
+/*
+ * @brief Slices date_str by position when the format has a numeric layout.
+ * @return true with year, month and day set if every field is made of plain
+ *         digits (no leading zero in %Y, %M, %D) and every literal matches.
+ *         false means the positional split does not apply and the caller
+ *         has to fall back to its generic parser.
+ * @note Only the digits are checked here; whether the values form a valid
+ *       date is left to the calendar system.
+ */
+bool DateFormat::extract_numeric_fields(const std::string& date_str,
+        int& year, int& month, int& day) const {
+    if (!_numeric_layout) {
+        return false;
+    }
+    std::size_t variable_width = 0;
+    if (_fixed_widths) {
+        if (date_str.size() != _fixed_length) {
+            return false;
+        }
+    } else {
+        if (date_str.size() <= _fixed_length) {
+            return false;
+        }
+        variable_width = date_str.size() - _fixed_length;
+    }
+    const char* s = date_str.data();
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < _tokens.size(); ++i) {
+        const Token& token = _tokens[i];
+        if (token.field == LITERAL) {
+            if (date_str.compare(pos, token.width, token.literal) != 0) {
+                return false;
+            }
+            pos += token.width;
+            continue;
+        }
+        const std::size_t width = token.width ? token.width : variable_width;
+        const std::size_t max_width = (token.field == YEAR) ? 9 : 2;
+        if (width > max_width || (token.uppercase && s[pos] == '0')) {
+            return false;
+        }
+        int value = 0;
+        for (std::size_t k = 0; k < width; ++k) {
+            const unsigned int digit
+                = static_cast<unsigned char>(s[pos + k]) - '0';
+            if (digit > 9) {
+                return false;
+            }
+            value = value * 10 + static_cast<int>(digit);
+        }
+        pos += width;
+        if (token.field == YEAR) {
+            year = value;
+        } else if (token.field == MONTH) {
+            month = value;
+        } else {
+            day = value;
+        }
+    }
+    return true;
+}
+
+}  // namespace toolbox
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace toolbox {
+
+/**
+ * @brief A date format string ("%Y-%m-%d", "%D/%M/%Y %E", ...) compiled once
+ * into a sequence of tokens, so that parsing and formatting no longer
+ * re-interpret the specifiers character by character.
+ *
+ * The plan is calendar independent: it records the field order, the literal
+ * separators between fields and the width each field takes in a date string
+ * ("%y", "%m" and "%d" are two characters wide, every other field has a
+ * variable width). What a field means (a number, a month name, ...) is still
+ * decided by the calendar system that uses the plan.
+ */
+class DateFormat {
+ public:
+    enum Field {
+        LITERAL,
+        ERA,
+        YEAR,
+        MONTH,
+        DAY,
+        WEEKDAY
+    };
+
+    struct Token {
+        Field field;
+        bool uppercase;       // %E/%Y/%M/%D/%W rather than %e/%y/%m/%d/%w
+        std::size_t width;    // characters in a date string, 0 = variable
+        std::string literal;  // LITERAL only ("%%" contributes a '%')
+    };
+
+    DateFormat();
+    DateFormat(const DateFormat& other);
+    DateFormat& operator=(const DateFormat& other);
+    ~DateFormat();
+
+    explicit DateFormat(const char* format);
+
+    const char* c_str() const;
+    std::size_t size() const;
+    const Token& operator[](std::size_t i) const;
+
+    bool has_field(Field field, bool uppercase) const;
+    bool has_fixed_widths() const;
+    bool has_numeric_layout() const;
+    bool extract_numeric_fields(const std::string& date_str,
+        int& year, int& month, int& day) const;
+
+ private:
+    std::string _format;
+    std::vector<Token> _tokens;
+    bool _fixed_widths;
+    bool _numeric_layout;
+    std::size_t _fixed_length;
+};
+
+}  // namespace toolbox
@@ -7,21 +7,43 @@
 #include <stdexcept>
 #include <cstring>
 
-#include <ex00/calendar_system/JulianCalendar.hpp>
+#include <ex00/calendar_system/YearTable.hpp>
 #include <toolbox/string.hpp>
+#include <ex00/calendar_system/DateBuffer.hpp>
 
 namespace {
 
+// What parse_serial_date reports; to_serial_date throws the same text.
+const toolbox::ParseResult parse_ok = {toolbox::ParseResult::OK, ""};
+const toolbox::ParseResult no_match = {toolbox::ParseResult::NO_MATCH,
+    "EthiopianCalendar::to_serial_date failed: "
+    "date string does not match the format"};
+const toolbox::ParseResult ambiguous = {toolbox::ParseResult::AMBIGUOUS,
+    "EthiopianCalendar::parse_formatted_date failed: "
+    "date_str is ambiguous"};
+
+// 1 Meskerem 1 is 29 August 8 (Julian).
+const int ethiopian_epoch = -716367;
+// Years converted through the year table; the others are computed.
+const int table_first_year = 1;
+const int table_last_year = 3000;
+
 bool is_leap(int year);
 int last_day_of_month(int year, int month);
+int year_start(int year);
+int first_day_of_year(int year);
+const toolbox::YearTable& year_table();
+void write_Ee(int era, bool uppercase, toolbox::DateBuffer& out);
+void write_Yy(int year, bool uppercase, toolbox::DateBuffer& out);
+void write_Mm(int month, bool uppercase, toolbox::DateBuffer& out);
+void write_Dd(int day, bool uppercase, toolbox::DateBuffer& out);
+void write_Ww(int day_of_week, bool uppercase, toolbox::DateBuffer& out);
 std::string to_string_Ee(int era, bool uppercase);
 std::string to_string_Yy(int year, bool uppercase);
 std::string to_string_Mm(int month, bool uppercase);
 std::string to_string_Dd(int day, bool uppercase);
 std::string to_string_Ww(int day_of_week, bool uppercase);
 
-toolbox::JulianCalendar julian;
-
 }  // namespace
 
 namespace toolbox {
@@ -67,15 +89,23 @@ int EthiopianCalendar::to_serial_date(int era,
         throw std::out_of_range("EthiopianCalendar::to_serial_date failed: "
             "day must be in 1.." + toolbox::to_string(last_day));
     }
-    const int ethiopian_epoch = julian.to_serial_date(
-        toolbox::JulianCalendar::AD, 8, 8, 29);
-    // assume year >= 1
-    int serial = ethiopian_epoch
-        + 365 * (year - 1)
-        + (year - 1) / 4
-        + 30 * (month - 1)
-        + (day - 1);
-    return serial;
+    return first_day_of_year(year) + 30 * (month - 1) + (day - 1);
+}
+
+/*
+ * @brief Whether to_serial_date(era, year, month, day) has a result (rather
+ *        than throwing std::out_of_range).
+ */
+bool EthiopianCalendar::is_valid_date(int era,
+        int year, int month, int day) const {
+    if (era < 0 || era >= END_OF_ERA || year <= 0
+        || month < 1 || month > 13) {
+        return false;
+    }
+    if (era == BC) {
+        year = 1 - year;
+    }
+    return day >= 1 && day <= last_day_of_month(year, month);
 }
 
 int EthiopianCalendar::to_serial_date(const std::string& date_str,
@@ -84,46 +114,102 @@ int EthiopianCalendar::to_serial_date(const std::string& date_str,
         throw std::invalid_argument("EthiopianCalendar::to_serial_date failed: "
             "format is null");
     }
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
+    }
+    return serial;
+}
+
+/*
+ * @brief Non-throwing form of to_serial_date(date_str, format, strict).
+ * @return NO_MATCH or AMBIGUOUS (and serial_date unchanged) for the inputs
+ *         to_serial_date rejects.
+ * @throw std::invalid_argument if format is null or gives a field twice.
+ */
+ParseResult EthiopianCalendar::parse_serial_date(const std::string& date_str,
+        const char* format, bool strict, int& serial_date) const {
+    if (!format) {
+        throw std::invalid_argument(
+            "EthiopianCalendar::parse_serial_date failed: format is null");
+    }
     int era = 0, year = 0, month = 0, day = 0;
-    bool all_found = false;
+    int match_count = 0;
     int serial = 0;
     parse_formatted_date(date_str, 0, format,
         era, false,
         year, false,
         month, false,
         day, false,
-        all_found,
+        match_count,
         serial,
         strict);
-    if (!all_found) {
-        throw std::invalid_argument("EthiopianCalendar::to_serial_date failed: "
-            "date string does not match the format");
+    if (match_count != 1) {
+        return match_count == 0 ? no_match : ambiguous;
     }
-    return to_serial_date(era, year, month, day);
+    serial_date = serial;
+    return parse_ok;
+}
+
+int EthiopianCalendar::to_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict) const {
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
+    }
+    return serial;
+}
+
+/*
+ * @brief Same as the const char* overload, but with a precompiled format.
+ * @note Numeric layouts are sliced by position and validated once; any other
+ *       format (or a date string the positional split does not apply to)
+ *       goes through the generic parser.
+ */
+ParseResult EthiopianCalendar::parse_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict, int& serial_date) const {
+    int year, month, day;
+    if (format.has_numeric_layout()
+        && !format.has_field(DateFormat::MONTH, false)
+        && format.extract_numeric_fields(date_str, year, month, day)) {
+        // The generic parser starts from era 0 (BC) as well.
+        if (!is_valid_date(BC, year, month, day)) {
+            return no_match;
+        }
+        serial_date = to_serial_date(BC, year, month, day);
+        return parse_ok;
+    }
+    return parse_serial_date(date_str, format.c_str(), strict, serial_date);
 }
 
 void EthiopianCalendar::from_serial_date(int serial_date,
         int& era, int& year, int& month, int& day) const {
-    const int ethiopian_epoch = julian.to_serial_date(
-        toolbox::JulianCalendar::AD, 8, 8, 29);
     if (serial_date < ethiopian_epoch) {
         throw std::out_of_range("EthiopianCalendar::from_serial_date failed: "
             "serial_date is out of range");
     }
-    int z = serial_date - ethiopian_epoch - 365;
-    int era_year = (z >= 0 ? z : z - 1460) / 1461;
-    int doe = z - era_year * 1461;
-    int yoe = (doe - doe / 1460) / 365;
-    year = yoe + era_year * 4 + 2;
-    int doy = doe - (365 * yoe + yoe / 4);
-    month = doy / 30 + 1;
-    day = doy % 30 + 1;
-    if (year <= 0) {
-        era = EthiopianCalendar::BC;
-        year = 1 - year;
-    } else {
+    int day_of_year;
+    if (year_table().find(serial_date, year, day_of_year)) {
+        month = day_of_year / 30 + 1;
+        day = day_of_year % 30 + 1;
         era = EthiopianCalendar::AD;
+        return;
     }
+    // Counted from the 1 BC new year, so that the leap year (year % 4 == 3)
+    // ends each 4-year cycle.
+    const int z = serial_date - ethiopian_epoch + 365;
+    const int era_year = z / 1461;
+    const int doe = z - era_year * 1461;
+    const int yoe = (doe - doe / 1460) / 365;
+    year = era_year * 4 + yoe;
+    day_of_year = doe - 365 * yoe;
+    month = day_of_year / 30 + 1;
+    day = day_of_year % 30 + 1;
+    era = EthiopianCalendar::AD;
 }
 
 void EthiopianCalendar::from_serial_date(int serial_date,
@@ -177,12 +263,112 @@ void EthiopianCalendar::from_serial_date(int serial_date,
     date_str = ss.str();
 }
 
+void EthiopianCalendar::from_serial_date(int serial_date,
+        std::string& date_str, const DateFormat& format) const {
+    int era, year, month, day;
+    from_serial_date(serial_date, era, year, month, day);
+    int day_of_week;
+    from_serial_date(serial_date, day_of_week);
+    std::string result;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const DateFormat::Token& token = format[i];
+        switch (token.field) {
+            case DateFormat::LITERAL:
+                result += token.literal;
+                break;
+            case DateFormat::ERA:
+                result += to_string_Ee(era, token.uppercase);
+                break;
+            case DateFormat::YEAR:
+                result += to_string_Yy(year, token.uppercase);
+                break;
+            case DateFormat::MONTH:
+                result += to_string_Mm(month, token.uppercase);
+                break;
+            case DateFormat::DAY:
+                result += to_string_Dd(day, token.uppercase);
+                break;
+            case DateFormat::WEEKDAY:
+                result += to_string_Ww(day_of_week, token.uppercase);
+                break;
+        }
+    }
+    date_str.swap(result);
+}
+
+/*
+ * @brief Formats serial_date into buffer[0, size), followed by a '\0',
+ *        without allocating.
+ * @return The length of the formatted date ('\0' excluded).
+ * @throw std::length_error if the date and its '\0' do not fit in size
+ *        bytes (see DATE_BUFFER_SIZE); the contents of buffer are then
+ *        unspecified.
+ */
+std::size_t EthiopianCalendar::from_serial_date(int serial_date,
+        char* buffer, std::size_t size, const DateFormat& format) const {
+    int era, year, month, day;
+    from_serial_date(serial_date, era, year, month, day);
+    int day_of_week;
+    from_serial_date(serial_date, day_of_week);
+    DateBuffer out(buffer, size);
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const DateFormat::Token& token = format[i];
+        switch (token.field) {
+            case DateFormat::LITERAL:
+                out.append(token.literal);
+                break;
+            case DateFormat::ERA:
+                write_Ee(era, token.uppercase, out);
+                break;
+            case DateFormat::YEAR:
+                write_Yy(year, token.uppercase, out);
+                break;
+            case DateFormat::MONTH:
+                write_Mm(month, token.uppercase, out);
+                break;
+            case DateFormat::DAY:
+                write_Dd(day, token.uppercase, out);
+                break;
+            case DateFormat::WEEKDAY:
+                write_Ww(day_of_week, token.uppercase, out);
+                break;
+        }
+    }
+    return out.size();
+}
+
 void EthiopianCalendar::from_serial_date(int serial_date,
         int& day_of_week) const {
     day_of_week = serial_date >= -4 ?
             (serial_date + 4) % 7 : (serial_date + 5) % 7 + 6;
 }
 
+/*
+ * @brief Batch form of to_serial_date(era, year, month, day).
+ * @note The single conversion is called without virtual dispatch.
+ */
+void EthiopianCalendar::to_serial_dates(const int* eras, const int* years,
+        const int* months, const int* days, std::size_t count,
+        int* serial_dates) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        serial_dates[i] = EthiopianCalendar::to_serial_date(
+            eras[i], years[i], months[i], days[i]);
+    }
+}
+
+/*
+ * @brief Batch form of from_serial_date(serial_date, era, year, month, day).
+ * @note The single conversion is called without virtual dispatch.
+ */
+void EthiopianCalendar::from_serial_dates(const int* serial_dates,
+        std::size_t count,
+        int* eras, int* years, int* months, int* days) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        EthiopianCalendar::from_serial_date(
+            serial_dates[i], eras[i], years[i], months[i], days[i]);
+    }
+}
+
 void EthiopianCalendar::parse_formatted_date(
     const std::string& date_str,
     std::size_t pos,
@@ -191,25 +377,18 @@ void EthiopianCalendar::parse_formatted_date(
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict) const {
     if (pos >= date_str.size() && !*format) {
         if (year_found && month_found && day_found) {
-            try {
-                int ret = to_serial_date(era, year, month, day);
-                if (!all_found) {
-                    serial = ret;
-                }
-            } catch (std::exception &e) {
+            if (!is_valid_date(era, year, month, day)) {
                 return;
             }
-            if (all_found) {
-                throw std::invalid_argument(
-                    "EthiopianCalendar::parse_formatted_date failed: "
-                    "date_str is ambiguous");
+            if (match_count == 0) {
+                serial = to_serial_date(era, year, month, day);
             }
-            all_found = true;
+            ++match_count;  // more than one match: date_str is ambiguous
         }
         return;
     }
@@ -222,7 +401,7 @@ void EthiopianCalendar::parse_formatted_date(
             year, year_found,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -243,7 +422,7 @@ void EthiopianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -260,7 +439,7 @@ void EthiopianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -277,7 +456,7 @@ void EthiopianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -294,7 +473,7 @@ void EthiopianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -308,7 +487,7 @@ void EthiopianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -327,7 +506,7 @@ void EthiopianCalendar::parse_Ee(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -350,16 +529,12 @@ void EthiopianCalendar::parse_Ee(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
         }
     }
-    throw std::invalid_argument(
-        "EthiopianCalendar::parse_Ee failed: "
-        "era not found in date_str at position "
-        + toolbox::to_string(pos));
 }
 
 void EthiopianCalendar::parse_Yy(const std::string& date_str,
@@ -369,7 +544,7 @@ void EthiopianCalendar::parse_Yy(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -384,10 +559,7 @@ void EthiopianCalendar::parse_Yy(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string year_str = date_str.substr(pos, num_len);
-            try {
-                year = toolbox::stoi(year_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, year)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -395,10 +567,10 @@ void EthiopianCalendar::parse_Yy(const std::string& date_str,
                 year, true,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -407,10 +579,7 @@ void EthiopianCalendar::parse_Yy(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string year_str = date_str.substr(pos, 2);
-        try {
-            year = toolbox::stoi(year_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, year)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -418,7 +587,7 @@ void EthiopianCalendar::parse_Yy(const std::string& date_str,
             year, true,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -432,7 +601,7 @@ void EthiopianCalendar::parse_Mm(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -447,10 +616,7 @@ void EthiopianCalendar::parse_Mm(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string month_str = date_str.substr(pos, num_len);
-            try {
-                month = toolbox::stoi(month_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, month)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -458,10 +624,10 @@ void EthiopianCalendar::parse_Mm(const std::string& date_str,
                 year, year_found,
                 month, true,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -492,7 +658,7 @@ void EthiopianCalendar::parse_Mm(const std::string& date_str,
                     year, year_found,
                     month, true,
                     day, day_found,
-                    all_found,
+                    match_count,
                     serial,
                     strict);
                 return;
@@ -508,7 +674,7 @@ void EthiopianCalendar::parse_Dd(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -523,10 +689,7 @@ void EthiopianCalendar::parse_Dd(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string day_str = date_str.substr(pos, num_len);
-            try {
-                day = toolbox::stoi(day_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, day)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -534,10 +697,10 @@ void EthiopianCalendar::parse_Dd(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, true,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -546,10 +709,7 @@ void EthiopianCalendar::parse_Dd(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string day_str = date_str.substr(pos, 2);
-        try {
-            day = toolbox::stoi(day_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, day)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -557,7 +717,7 @@ void EthiopianCalendar::parse_Dd(const std::string& date_str,
             year, year_found,
             month, month_found,
             day, true,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -583,7 +743,30 @@ int last_day_of_month(int year, int month) {
     return 30;
 }
 
-std::string to_string_Ee(int era, bool uppercase) {
+// assume year >= 1
+int year_start(int year) {
+    return ethiopian_epoch
+        + 365 * (year - 1)
+        + year / 4;  // Leap year every 4 years (3, 7, 11, ...)
+}
+
+int first_day_of_year(int year) {
+    const toolbox::YearTable& table = year_table();
+    return table.contains(year) ? table.year_start(year) : year_start(year);
+}
+
+/*
+ * @brief Year starts of years table_first_year..table_last_year, built on
+ *        first use.
+ * @note [complexity]: O(1) after the first call
+ */
+const toolbox::YearTable& year_table() {
+    static const toolbox::YearTable table(table_first_year, table_last_year,
+        year_start);
+    return table;
+}
+
+void write_Ee(int era, bool uppercase, toolbox::DateBuffer& out) {
     const char* era_str_E[] = {
         /* [toolbox::EthiopianCalendar::BC] = */ "B.C.",
         /* [toolbox::EthiopianCalendar::AD] = */ "A.D.",
@@ -596,11 +779,10 @@ std::string to_string_Ee(int era, bool uppercase) {
         throw std::out_of_range(
             "to_string_Ee failed: Invalid era: " + toolbox::to_string(era));
     }
-    return uppercase ? era_str_E[era] : era_str_e[era];
+    out.append(uppercase ? era_str_E[era] : era_str_e[era]);
 }
 
-std::string to_string_Yy(int year, bool uppercase) {
-    std::ostringstream oss;
+void write_Yy(int year, bool uppercase, toolbox::DateBuffer& out) {
     if (year < 0) {
         throw std::out_of_range("to_string_Yy failed: year must be positive");
     } else if (year == 0) {
@@ -608,14 +790,13 @@ std::string to_string_Yy(int year, bool uppercase) {
             "year 0 does not exist in Ethiopian calendar");
     }
     if (uppercase) {
-        oss << year;
+        out.append_number(year);
     } else {
-        oss << std::setw(4) << std::setfill('0') << year;
+        out.append_number(year, 4);
     }
-    return oss.str();
 }
 
-std::string to_string_Mm(int month, bool uppercase) {
+void write_Mm(int month, bool uppercase, toolbox::DateBuffer& out) {
     const char *month_str_m[] = {
         /* 1  = */ "Meskerem",
         /* 2  = */ "Tikemet",
@@ -635,29 +816,25 @@ std::string to_string_Mm(int month, bool uppercase) {
         throw std::out_of_range("to_string_Mm failed: "
             "month must be in 1..13");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << month;
+        out.append_number(month);
     } else {
-        oss << month_str_m[month - 1];
+        out.append(month_str_m[month - 1]);
     }
-    return oss.str();
 }
 
-std::string to_string_Dd(int day, bool uppercase) {
+void write_Dd(int day, bool uppercase, toolbox::DateBuffer& out) {
     if (day < 1 || day > 30) {
         throw std::out_of_range("to_string_Dd failed: day must be in 1..30");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << day;
+        out.append_number(day);
     } else {
-        oss << std::setw(2) << std::setfill('0') << day;
+        out.append_number(day, 2);
     }
-    return oss.str();
 }
 
-std::string to_string_Ww(int day_of_week, bool uppercase) {
+void write_Ww(int day_of_week, bool uppercase, toolbox::DateBuffer& out) {
     const char* day_of_week_str_W[] = {
         /* [0] = */ "Ehud",
         /* [1] = */ "Segno",
@@ -674,8 +851,43 @@ std::string to_string_Ww(int day_of_week, bool uppercase) {
     if (day_of_week < 0 || day_of_week > 6) {
         throw std::out_of_range("to_string_Ww: day_of_week must be in 0..6");
     }
-    return uppercase ?
-        day_of_week_str_W[day_of_week] : day_of_week_str_w[day_of_week];
+    out.append(uppercase ?
+        day_of_week_str_W[day_of_week] : day_of_week_str_w[day_of_week]);
+}
+
+std::string to_string_Ee(int era, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Ee(era, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Yy(int year, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Yy(year, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Mm(int month, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Mm(month, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Dd(int day, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Dd(day, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Ww(int day_of_week, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Ww(day_of_week, uppercase, out);
+    return std::string(out.data(), out.size());
 }
 
 }  // namespace
@@ -8,24 +8,44 @@
 #include <cstring>
 
 #include <toolbox/string.hpp>
-#include <ex00/calendar_system/GregorianCalendar.hpp>
+#include <ex00/calendar_system/DateBuffer.hpp>
+#include <ex00/calendar_system/YearTable.hpp>
 
 namespace {
+// What parse_serial_date reports; to_serial_date throws the same text.
+const toolbox::ParseResult parse_ok = {toolbox::ParseResult::OK, ""};
+const toolbox::ParseResult no_match = {toolbox::ParseResult::NO_MATCH,
+    "FrenchRepublicanCalendar::to_serial_date failed: "
+    "date_str does not match format"};
+const toolbox::ParseResult ambiguous = {toolbox::ParseResult::AMBIGUOUS,
+    "FrenchRepublicanCalendar::parse_formatted_date failed: "
+    "date_str is ambiguous"};
+
+// The French Republican Calendar started on 22 September 1792 (Gregorian);
+// dates are converted up to 31 December 1806 (Gregorian), in year 15.
+const int start_serial = -64748;  // 1792-09-22 (Gregorian)
+const int end_serial = -59536;  // 1806-12-31 (Gregorian)
+
 bool is_leap(int year);
 int last_day_of_month(int year, int month);
+int year_start(int year);
+const toolbox::YearTable& year_table();
 
-std::string get_month_name(int month);
-std::string get_day_name(int month, int day);
-std::string get_day_of_week_name(int day_of_week);
+const char* get_month_name(int month);
+const char* get_day_name(int month, int day);
+const char* get_day_of_week_name(int day_of_week);
 
+void write_Ee(int era, bool uppercase, toolbox::DateBuffer& out);
+void write_Yy(int year, bool uppercase, toolbox::DateBuffer& out);
+void write_Mm(int month, bool uppercase, toolbox::DateBuffer& out);
+void write_Dd(int month, int day, bool uppercase, toolbox::DateBuffer& out);
+void write_Ww(int day_of_week, bool uppercase, toolbox::DateBuffer& out);
 std::string to_string_Ee(int era, bool uppercase);
 std::string to_string_Yy(int year, bool uppercase);
 std::string to_string_Mm(int month, bool uppercase);
 std::string to_string_Dd(int month, int day, bool uppercase);
 std::string to_string_Ww(int day_of_week, bool uppercase);
 
-toolbox::GregorianCalendar gregorian;
-
 }  // namespace
 
 namespace toolbox {
@@ -71,16 +91,19 @@ int FrenchRepublicanCalendar::to_serial_date(int era,
             "FrenchRepublicanCalendar::to_serial_date failed: "
             "day is out of range for month " + toolbox::to_string(month));
     }
+    return year_table().year_start(year) + (month - 1) * 30 + (day - 1);
+}
 
-    // The French Republican Calendar started on 22 September 1792 (Gregorian).
-    const int start_serial = gregorian.to_serial_date(
-        GregorianCalendar::AD, 1792, 9, 22);
-    const int serial = start_serial
-        + (year - 1) * 365
-        + year / 4  // Leap year every 4 years (3, 7, 11)
-        + (month - 1) * 30
-        + (day - 1);
-    return serial;
+/*
+ * @brief Whether to_serial_date(era, year, month, day) has a result (rather
+ *        than throwing std::out_of_range).
+ */
+bool FrenchRepublicanCalendar::is_valid_date(int era,
+        int year, int month, int day) const {
+    return era >= 0 && era < END_OF_ERA
+        && year >= 1 && year <= 14
+        && month >= 1 && month <= 13
+        && day >= 1 && day <= last_day_of_month(year, month);
 }
 
 int FrenchRepublicanCalendar::to_serial_date(const std::string& date_str,
@@ -90,43 +113,91 @@ int FrenchRepublicanCalendar::to_serial_date(const std::string& date_str,
             "FrenchRepublicanCalendar::to_serial_date failed: "
             "format is null");
     }
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
+    }
+    return serial;
+}
+
+/*
+ * @brief Non-throwing form of to_serial_date(date_str, format, strict).
+ * @return NO_MATCH or AMBIGUOUS (and serial_date unchanged) for the inputs
+ *         to_serial_date rejects.
+ * @throw std::invalid_argument if format is null or gives a field twice.
+ */
+ParseResult FrenchRepublicanCalendar::parse_serial_date(
+        const std::string& date_str, const char* format, bool strict,
+        int& serial_date) const {
+    if (!format) {
+        throw std::invalid_argument(
+            "FrenchRepublicanCalendar::parse_serial_date failed: "
+            "format is null");
+    }
     int era = FrenchRepublicanCalendar::AD;
     int year = 0, month = 0, day = 0;
-    bool all_found = false;
+    int match_count = 0;
     int serial = 0;
     parse_formatted_date(date_str, 0, format,
         era, false,
         year, false,
         month, false,
         day, false,
-        all_found,
+        match_count,
         serial,
         strict);
-    if (!all_found) {
-        throw std::invalid_argument(
-            "FrenchRepublicanCalendar::to_serial_date failed: "
-            "date_str does not match format");
+    if (match_count != 1) {
+        return match_count == 0 ? no_match : ambiguous;
+    }
+    serial_date = serial;
+    return parse_ok;
+}
+
+int FrenchRepublicanCalendar::to_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict) const {
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
     }
     return serial;
 }
 
+/*
+ * @brief Same as the const char* overload, but with a precompiled format.
+ * @note Numeric layouts are sliced by position and validated once; any other
+ *       format (or a date string the positional split does not apply to)
+ *       goes through the generic parser.
+ */
+ParseResult FrenchRepublicanCalendar::parse_serial_date(
+        const std::string& date_str, const DateFormat& format, bool strict,
+        int& serial_date) const {
+    int year, month, day;
+    if (format.has_numeric_layout()
+        && !format.has_field(DateFormat::MONTH, false)
+        && !format.has_field(DateFormat::DAY, false)
+        && format.extract_numeric_fields(date_str, year, month, day)) {
+        if (!is_valid_date(AD, year, month, day)) {
+            return no_match;
+        }
+        serial_date = to_serial_date(AD, year, month, day);
+        return parse_ok;
+    }
+    return parse_serial_date(date_str, format.c_str(), strict, serial_date);
+}
+
 void FrenchRepublicanCalendar::from_serial_date(int serial_date,
         int& era, int& year, int& month, int& day) const {
-    const int start_serial = gregorian.to_serial_date(
-        GregorianCalendar::AD, 1792, 9, 22);
-    const int end_serial = gregorian.to_serial_date(
-        GregorianCalendar::AD, 1806, 12, 31);
-    if (serial_date < start_serial || serial_date > end_serial) {
+    int doy;
+    if (serial_date < start_serial || serial_date > end_serial
+        || !year_table().find(serial_date, year, doy)) {
         throw std::out_of_range(
             "FrenchRepublicanCalendar::from_serial_date failed: "
             "serial_date is out of range");
     }
-    const int z = serial_date - start_serial;
-    const int era_year = z / 1461;  // 4 years
-    const int doe = z - era_year * 1461;
-    const int yoe = (doe - doe / 1095) / 365;  // Leap year (3, 7, 11)
-    year = era_year * 4 + yoe + 1;
-    const int doy = doe - (yoe * 365 + (yoe + 1) / 4);
     month = doy / 30 + 1;
     day = doy % 30 + 1;
     era = FrenchRepublicanCalendar::AD;
@@ -183,6 +254,80 @@ void FrenchRepublicanCalendar::from_serial_date(int serial_date,
     date_str = ss.str();
 }
 
+void FrenchRepublicanCalendar::from_serial_date(int serial_date,
+        std::string& date_str, const DateFormat& format) const {
+    int era, year, month, day;
+    from_serial_date(serial_date, era, year, month, day);
+    int day_of_week;
+    from_serial_date(serial_date, day_of_week);
+    std::string result;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const DateFormat::Token& token = format[i];
+        switch (token.field) {
+            case DateFormat::LITERAL:
+                result += token.literal;
+                break;
+            case DateFormat::ERA:
+                result += to_string_Ee(era, token.uppercase);
+                break;
+            case DateFormat::YEAR:
+                result += to_string_Yy(year, token.uppercase);
+                break;
+            case DateFormat::MONTH:
+                result += to_string_Mm(month, token.uppercase);
+                break;
+            case DateFormat::DAY:
+                result += to_string_Dd(month, day, token.uppercase);
+                break;
+            case DateFormat::WEEKDAY:
+                result += to_string_Ww(day_of_week, token.uppercase);
+                break;
+        }
+    }
+    date_str.swap(result);
+}
+
+/*
+ * @brief Formats serial_date into buffer[0, size), followed by a '\0',
+ *        without allocating.
+ * @return The length of the formatted date ('\0' excluded).
+ * @throw std::length_error if the date and its '\0' do not fit in size
+ *        bytes (see DATE_BUFFER_SIZE); the contents of buffer are then
+ *        unspecified.
+ */
+std::size_t FrenchRepublicanCalendar::from_serial_date(int serial_date,
+        char* buffer, std::size_t size, const DateFormat& format) const {
+    int era, year, month, day;
+    from_serial_date(serial_date, era, year, month, day);
+    int day_of_week;
+    from_serial_date(serial_date, day_of_week);
+    DateBuffer out(buffer, size);
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const DateFormat::Token& token = format[i];
+        switch (token.field) {
+            case DateFormat::LITERAL:
+                out.append(token.literal);
+                break;
+            case DateFormat::ERA:
+                write_Ee(era, token.uppercase, out);
+                break;
+            case DateFormat::YEAR:
+                write_Yy(year, token.uppercase, out);
+                break;
+            case DateFormat::MONTH:
+                write_Mm(month, token.uppercase, out);
+                break;
+            case DateFormat::DAY:
+                write_Dd(month, day, token.uppercase, out);
+                break;
+            case DateFormat::WEEKDAY:
+                write_Ww(day_of_week, token.uppercase, out);
+                break;
+        }
+    }
+    return out.size();
+}
+
 void FrenchRepublicanCalendar::from_serial_date(int serial_date,
         int& day_of_week) const {
     int era, year, month, day;
@@ -190,6 +335,33 @@ void FrenchRepublicanCalendar::from_serial_date(int serial_date,
     day_of_week = (day - 1) % 10;  // 10-day week
 }
 
+/*
+ * @brief Batch form of to_serial_date(era, year, month, day).
+ * @note The single conversion is called without virtual dispatch.
+ */
+void FrenchRepublicanCalendar::to_serial_dates(
+        const int* eras, const int* years,
+        const int* months, const int* days, std::size_t count,
+        int* serial_dates) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        serial_dates[i] = FrenchRepublicanCalendar::to_serial_date(
+            eras[i], years[i], months[i], days[i]);
+    }
+}
+
+/*
+ * @brief Batch form of from_serial_date(serial_date, era, year, month, day).
+ * @note The single conversion is called without virtual dispatch.
+ */
+void FrenchRepublicanCalendar::from_serial_dates(const int* serial_dates,
+        std::size_t count,
+        int* eras, int* years, int* months, int* days) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        FrenchRepublicanCalendar::from_serial_date(
+            serial_dates[i], eras[i], years[i], months[i], days[i]);
+    }
+}
+
 void FrenchRepublicanCalendar::parse_formatted_date(const std::string& date_str,
     std::size_t pos,
     const char* format,
@@ -197,25 +369,18 @@ void FrenchRepublicanCalendar::parse_formatted_date(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict) const {
     if (pos >= date_str.size() && !*format) {
         if (year_found && month_found && day_found) {
-            try {
-                int ret = to_serial_date(era, year, month, day);
-                if (!all_found) {
-                    serial = ret;
-                }
-            } catch (std::exception &e) {
+            if (!is_valid_date(era, year, month, day)) {
                 return;
             }
-            if (all_found) {
-                throw std::invalid_argument(
-                    "FrenchRepublicanCalendar::parse_formatted_date failed: "
-                    "date_str is ambiguous");
+            if (match_count == 0) {
+                serial = to_serial_date(era, year, month, day);
             }
-            all_found = true;
+            ++match_count;  // more than one match: date_str is ambiguous
         }
         return;
     }
@@ -228,7 +393,7 @@ void FrenchRepublicanCalendar::parse_formatted_date(const std::string& date_str,
             year, year_found,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -249,7 +414,7 @@ void FrenchRepublicanCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -266,7 +431,7 @@ void FrenchRepublicanCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -283,7 +448,7 @@ void FrenchRepublicanCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -300,7 +465,7 @@ void FrenchRepublicanCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -314,7 +479,7 @@ void FrenchRepublicanCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -333,7 +498,7 @@ void FrenchRepublicanCalendar::parse_Ee(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -354,16 +519,12 @@ void FrenchRepublicanCalendar::parse_Ee(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
         }
     }
-    throw std::invalid_argument(
-        "FrenchRepublicanCalendar::parse_Ee failed: "
-        "era not found in date_str at position "
-        + toolbox::to_string(pos));
 }
 
 void FrenchRepublicanCalendar::parse_Yy(const std::string& date_str,
@@ -373,7 +534,7 @@ void FrenchRepublicanCalendar::parse_Yy(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -388,10 +549,7 @@ void FrenchRepublicanCalendar::parse_Yy(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string year_str = date_str.substr(pos, num_len);
-            try {
-                year = toolbox::stoi(year_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, year)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -399,10 +557,10 @@ void FrenchRepublicanCalendar::parse_Yy(const std::string& date_str,
                 year, true,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -411,10 +569,7 @@ void FrenchRepublicanCalendar::parse_Yy(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string year_str = date_str.substr(pos, 2);
-        try {
-            year = toolbox::stoi(year_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, year)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -422,7 +577,7 @@ void FrenchRepublicanCalendar::parse_Yy(const std::string& date_str,
             year, true,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
     }
@@ -436,7 +591,7 @@ void FrenchRepublicanCalendar::parse_Mm(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -452,36 +607,32 @@ void FrenchRepublicanCalendar::parse_Mm(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string month_str = date_str.substr(pos, num_len);
-            try {
-                int m = toolbox::stoi(month_str);
-                if (!updated && !month_found && month != 0 && month != m) {
-                    throw std::invalid_argument(
-                        "FrenchRepublicanCalendar::parse_Mm failed: "
-                        "month value conflict");
-                }
-                updated = (month != m);
-                month = m;
-            } catch (std::exception &e) {
+            int m;
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, m)) {
                 continue;
             }
+            if (!updated && !month_found && month != 0 && month != m) {
+                continue;  // Value conflict
+            }
+            updated = (month != m);
+            month = m;
             parse_formatted_date(date_str, pos + num_len, format + 2,
                 era, era_found,
                 year, year_found,
                 month, true,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
     } else {
         // %m
         for (int m = 1; m <= 13; ++m) {
-            std::string month_name = get_month_name(m);
-            const std::size_t len = month_name.size();
+            const char* month_name = get_month_name(m);
+            const std::size_t len = std::strlen(month_name);
             if (date_str.compare(pos, len, month_name) != 0) {
                 continue;
             }
@@ -495,11 +646,11 @@ void FrenchRepublicanCalendar::parse_Mm(const std::string& date_str,
                 year, year_found,
                 month, true,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -513,7 +664,7 @@ void FrenchRepublicanCalendar::parse_Dd(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -528,10 +679,7 @@ void FrenchRepublicanCalendar::parse_Dd(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string day_str = date_str.substr(pos, num_len);
-            try {
-                day = toolbox::stoi(day_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, day)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -539,10 +687,10 @@ void FrenchRepublicanCalendar::parse_Dd(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, true,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -554,8 +702,8 @@ void FrenchRepublicanCalendar::parse_Dd(const std::string& date_str,
             }
             const int last_day = last_day_of_month(3, m);  // leap year
             for (int d = 1; d <= last_day; ++d) {
-                std::string day_name = get_day_name(m, d);
-                const std::size_t len = day_name.size();
+                const char* day_name = get_day_name(m, d);
+                const std::size_t len = std::strlen(day_name);
                 if (date_str.compare(pos, len, day_name) != 0) {
                     continue;
                 }
@@ -566,10 +714,10 @@ void FrenchRepublicanCalendar::parse_Dd(const std::string& date_str,
                     year, year_found,
                     month, month_found,
                     day, true,
-                    all_found,
+                    match_count,
                     serial,
                     strict);
-                if (all_found && !strict) {
+                if (match_count != 0 && !strict) {
                     return;
                 }
             }
@@ -597,9 +745,24 @@ int last_day_of_month(int year, int month) {
     return 30;
 }
 
+int year_start(int year) {
+    return start_serial
+        + (year - 1) * 365
+        + year / 4;  // Leap year every 4 years (3, 7, 11)
+}
+
+/*
+ * @brief Year starts of years 1..15, built on first use.
+ * @note [complexity]: O(1) after the first call
+ */
+const toolbox::YearTable& year_table() {
+    static const toolbox::YearTable table(1, 15, year_start);
+    return table;
+}
+
 // This implementation uses only ASCII characters.
 // In a real implementation, accented characters should be used.
-std::string get_month_name(int month) {
+const char* get_month_name(int month) {
     const char* month_names[] = {
         /* 1  = */ "Vendemiaire",
         /* 2  = */ "Brumaire",
@@ -622,7 +785,7 @@ std::string get_month_name(int month) {
     return month_names[month - 1];
 }
 
-std::string get_day_name(int month, int day) {
+const char* get_day_name(int month, int day) {
     if (month < 1 || month > 13) {
         throw std::out_of_range("get_day_name failed: "
             "month must be in 1..13");
@@ -740,7 +903,7 @@ std::string get_day_name(int month, int day) {
     return day_names[doy - 1];
 }
 
-std::string get_day_of_week_name(int day_of_week) {
+const char* get_day_of_week_name(int day_of_week) {
     const char* day_of_week_names[] = {
         /* 0 = */ "Primidi",
         /* 1 = */ "Duodi",
@@ -760,7 +923,7 @@ std::string get_day_of_week_name(int day_of_week) {
     return day_of_week_names[day_of_week];
 }
 
-std::string to_string_Ee(int era, bool uppercase) {
+void write_Ee(int era, bool uppercase, toolbox::DateBuffer& out) {
     const char* era_str_E[] = {
         /* [toolbox::FrenchRepublicanCalendar::AD] = */ "A.D.",
     };
@@ -771,37 +934,34 @@ std::string to_string_Ee(int era, bool uppercase) {
         throw std::out_of_range(
             "to_string_Ee failed: Invalid era: " + toolbox::to_string(era));
     }
-    return uppercase ? era_str_E[era] : era_str_e[era];
+    out.append(uppercase ? era_str_E[era] : era_str_e[era]);
 }
 
-std::string to_string_Yy(int year, bool uppercase) {
+void write_Yy(int year, bool uppercase, toolbox::DateBuffer& out) {
     if (year < 1 || year > 14) {
         throw std::out_of_range("to_string_Yy failed: "
             "year must be in 1..14");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << year;
+        out.append_number(year);
     } else {
-        oss << std::setw(2) << std::setfill('0') << year;
+        out.append_number(year, 2);
     }
-    return oss.str();
 }
 
-std::string to_string_Mm(int month, bool uppercase) {
+void write_Mm(int month, bool uppercase, toolbox::DateBuffer& out) {
     if (month < 1 || month > 13) {
         throw std::out_of_range("to_string_Mm failed: month must be in 1..13");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << month;
+        out.append_number(month);
     } else {
-        oss << get_month_name(month);
+        out.append(get_month_name(month));
     }
-    return oss.str();
 }
 
-std::string to_string_Dd(int month, int day, bool uppercase) {
+void write_Dd(int month, int day, bool uppercase,
+        toolbox::DateBuffer& out) {
     if (month < 1 || month > 13) {
         throw std::out_of_range("to_string_Dd failed: "
             "month must be in 1..13");
@@ -810,27 +970,58 @@ std::string to_string_Dd(int month, int day, bool uppercase) {
         throw std::out_of_range("to_string_Dd failed: "
             "day is out of range for month " + toolbox::to_string(month));
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << day;
+        out.append_number(day);
     } else {
-        oss << get_day_name(month, day);
+        out.append(get_day_name(month, day));
     }
-    return oss.str();
 }
 
-std::string to_string_Ww(int day_of_week, bool uppercase) {
+void write_Ww(int day_of_week, bool uppercase, toolbox::DateBuffer& out) {
     if (day_of_week < 0 || day_of_week > 9) {
         throw std::out_of_range("to_string_Ww failed: "
             "day_of_week must be in 0..9");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << day_of_week + 1;
+        out.append_number(day_of_week + 1);
     } else {
-        oss << get_day_of_week_name(day_of_week);
+        out.append(get_day_of_week_name(day_of_week));
     }
-    return oss.str();
+}
+
+std::string to_string_Ee(int era, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Ee(era, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Yy(int year, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Yy(year, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Mm(int month, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Mm(month, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Dd(int month, int day, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Dd(month, day, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Ww(int day_of_week, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Ww(day_of_week, uppercase, out);
+    return std::string(out.data(), out.size());
 }
 
 }  // namespace
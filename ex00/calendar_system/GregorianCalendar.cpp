@@ -8,11 +8,27 @@
 #include <cstring>
 
 #include <toolbox/string.hpp>
+#include <ex00/calendar_system/DateBuffer.hpp>
 
 namespace {
 
+// What parse_serial_date reports; to_serial_date throws the same text.
+const toolbox::ParseResult parse_ok = {toolbox::ParseResult::OK, ""};
+const toolbox::ParseResult no_match = {toolbox::ParseResult::NO_MATCH,
+    "GregorianCalendar::to_serial_date failed: "
+    "Something went wrong while parsing date_str"};
+const toolbox::ParseResult ambiguous = {toolbox::ParseResult::AMBIGUOUS,
+    "GregorianCalendar::parse_formatted_date failed: "
+    "date_str is ambiguous"};
+
 bool is_leap(int year);
 int last_day_of_month(int year, int month);
+int days_from_civil(int year, int month, int day);
+void write_Ee(int era, bool uppercase, toolbox::DateBuffer& out);
+void write_Yy(int year, bool uppercase, toolbox::DateBuffer& out);
+void write_Mm(int month, bool uppercase, toolbox::DateBuffer& out);
+void write_Dd(int day, bool uppercase, toolbox::DateBuffer& out);
+void write_Ww(int day_of_week, bool uppercase, toolbox::DateBuffer& out);
 std::string to_string_Ee(int era, bool uppercase);
 std::string to_string_Yy(int year, bool uppercase);
 std::string to_string_Mm(int month, bool uppercase);
@@ -64,13 +80,23 @@ int GregorianCalendar::to_serial_date(int era,
             "day is out of range for month " + toolbox::to_string(month)
             + " of year " + toolbox::to_string(year));
     }
-    year -= !!(month <= 2);
-    const int era_year = (year >= 0 ? year : year - 399) / 400;
-    const unsigned int yoe = static_cast<unsigned int>(year - era_year * 400);
-    const unsigned int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2)
-        / 5 + day - 1;
-    const unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
-    return era_year * 146097 + static_cast<int>(doe) - 719468;
+    return days_from_civil(year, month, day);
+}
+
+/*
+ * @brief Whether to_serial_date(era, year, month, day) has a result (rather
+ *        than throwing std::out_of_range).
+ */
+bool GregorianCalendar::is_valid_date(int era,
+        int year, int month, int day) const {
+    if (era < 0 || era >= END_OF_ERA || year <= 0
+        || month < 1 || month > 12) {
+        return false;
+    }
+    if (era == BC) {
+        year = 1 - year;
+    }
+    return day >= 1 && day <= last_day_of_month(year, month);
 }
 
 int GregorianCalendar::to_serial_date(const std::string& date_str,
@@ -79,25 +105,138 @@ int GregorianCalendar::to_serial_date(const std::string& date_str,
         throw std::invalid_argument("GregorianCalendar::to_serial_date failed: "
             "format is null");
     }
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
+    }
+    return serial;
+}
+
+/*
+ * @brief Non-throwing form of to_serial_date(date_str, format, strict).
+ * @return NO_MATCH or AMBIGUOUS (and serial_date unchanged) for the inputs
+ *         to_serial_date rejects.
+ * @throw std::invalid_argument if format is null or gives a field twice.
+ */
+ParseResult GregorianCalendar::parse_serial_date(const std::string& date_str,
+        const char* format, bool strict, int& serial_date) const {
+    if (!format) {
+        throw std::invalid_argument(
+            "GregorianCalendar::parse_serial_date failed: format is null");
+    }
+    ParseResult result = parse_ok;
+    if (std::strcmp(format, "%Y-%m-%d") == 0
+        && parse_iso_date(date_str, result, serial_date)) {
+        return result;
+    }
+    int serial = 0;
     int era = toolbox::GregorianCalendar::AD;
     int year = 0, month = 0, day = 0;
-    bool all_found = false;
-    int serial = 0;
+    int match_count = 0;
     parse_formatted_date(date_str, 0, format,
         era, false,
         year, false,
         month, false,
         day, false,
-        all_found,
+        match_count,
         serial,
         strict);
-    if (!all_found) {
-        throw std::invalid_argument("GregorianCalendar::to_serial_date failed: "
-            "Something went wrong while parsing date_str");
+    if (match_count != 1) {
+        return match_count == 0 ? no_match : ambiguous;
+    }
+    serial_date = serial;
+    return parse_ok;
+}
+
+/*
+ * @brief Fast path of parse_serial_date for the "%Y-%m-%d" format.
+ * @return true if date_str has the fixed-width "YYYY-MM-DD" shape, with
+ *         result set to what the generic parser would report (and
+ *         serial_date to the serial date if it is a valid date, unchanged
+ *         otherwise); false if the generic
+ *         parser has to decide (other shapes, such as years with more than
+ *         4 digits).
+ */
+bool GregorianCalendar::parse_iso_date(const std::string& date_str,
+        ParseResult& result, int& serial_date) {
+    return parse_iso_date(date_str.data(), date_str.size(), result,
+        serial_date);
+}
+
+/*
+ * @brief Same as the std::string overload, for the size characters at
+ *        date_str (which need not be null-terminated), so that a field of
+ *        a larger buffer is parsed in place.
+ */
+bool GregorianCalendar::parse_iso_date(const char* date_str,
+        std::size_t size, ParseResult& result, int& serial_date) {
+    if (size != 10 || date_str[4] != '-' || date_str[7] != '-') {
+        return false;
+    }
+    const char* s = date_str;
+    const unsigned int d0 = static_cast<unsigned char>(s[0]) - '0';
+    const unsigned int d1 = static_cast<unsigned char>(s[1]) - '0';
+    const unsigned int d2 = static_cast<unsigned char>(s[2]) - '0';
+    const unsigned int d3 = static_cast<unsigned char>(s[3]) - '0';
+    const unsigned int d5 = static_cast<unsigned char>(s[5]) - '0';
+    const unsigned int d6 = static_cast<unsigned char>(s[6]) - '0';
+    const unsigned int d8 = static_cast<unsigned char>(s[8]) - '0';
+    const unsigned int d9 = static_cast<unsigned char>(s[9]) - '0';
+    if (d0 > 9 || d1 > 9 || d2 > 9 || d3 > 9
+        || d5 > 9 || d6 > 9 || d8 > 9 || d9 > 9 || d0 == 0) {
+        return false;
+    }
+    const int year = static_cast<int>(d0 * 1000 + d1 * 100 + d2 * 10 + d3);
+    const int month = static_cast<int>(d5 * 10 + d6);
+    const int day = static_cast<int>(d8 * 10 + d9);
+    if (month < 1 || month > 12
+        || day < 1 || day > last_day_of_month(year, month)) {
+        result = no_match;
+        return true;
+    }
+    serial_date = days_from_civil(year, month, day);
+    result = parse_ok;
+    return true;
+}
+
+int GregorianCalendar::to_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict) const {
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
     }
     return serial;
 }
 
+/*
+ * @brief Same as the const char* overload, but with a precompiled format.
+ * @note Numeric layouts are sliced by position and validated once; any other
+ *       format (or a date string the positional split does not apply to)
+ *       goes through the generic parser.
+ */
+ParseResult GregorianCalendar::parse_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict, int& serial_date) const {
+    ParseResult result = parse_ok;
+    if (std::strcmp(format.c_str(), "%Y-%m-%d") == 0
+        && parse_iso_date(date_str, result, serial_date)) {
+        return result;
+    }
+    int year, month, day;
+    if (format.has_numeric_layout()
+        && format.extract_numeric_fields(date_str, year, month, day)) {
+        if (!is_valid_date(AD, year, month, day)) {
+            return no_match;
+        }
+        serial_date = to_serial_date(AD, year, month, day);
+        return parse_ok;
+    }
+    return parse_serial_date(date_str, format.c_str(), strict, serial_date);
+}
+
 void GregorianCalendar::from_serial_date(int serial_date,
         int& era, int& year, int& month, int& day) const {
     (void)era;
@@ -170,12 +309,157 @@ void GregorianCalendar::from_serial_date(int serial_date,
     date_str = ss.str();
 }
 
+void GregorianCalendar::from_serial_date(int serial_date,
+        std::string& date_str, const DateFormat& format) const {
+    int era, year, month, day;
+    from_serial_date(serial_date, era, year, month, day);
+    int day_of_week;
+    from_serial_date(serial_date, day_of_week);
+    std::string result;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const DateFormat::Token& token = format[i];
+        switch (token.field) {
+            case DateFormat::LITERAL:
+                result += token.literal;
+                break;
+            case DateFormat::ERA:
+                result += to_string_Ee(era, token.uppercase);
+                break;
+            case DateFormat::YEAR:
+                result += to_string_Yy(year, token.uppercase);
+                break;
+            case DateFormat::MONTH:
+                result += to_string_Mm(month, token.uppercase);
+                break;
+            case DateFormat::DAY:
+                result += to_string_Dd(day, token.uppercase);
+                break;
+            case DateFormat::WEEKDAY:
+                result += to_string_Ww(day_of_week, token.uppercase);
+                break;
+        }
+    }
+    date_str.swap(result);
+}
+
+/*
+ * @brief Formats serial_date into buffer[0, size), followed by a '\0',
+ *        without allocating.
+ * @return The length of the formatted date ('\0' excluded).
+ * @throw std::length_error if the date and its '\0' do not fit in size
+ *        bytes (see DATE_BUFFER_SIZE); the contents of buffer are then
+ *        unspecified.
+ */
+std::size_t GregorianCalendar::from_serial_date(int serial_date,
+        char* buffer, std::size_t size, const DateFormat& format) const {
+    int era, year, month, day;
+    from_serial_date(serial_date, era, year, month, day);
+    int day_of_week;
+    from_serial_date(serial_date, day_of_week);
+    DateBuffer out(buffer, size);
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const DateFormat::Token& token = format[i];
+        switch (token.field) {
+            case DateFormat::LITERAL:
+                out.append(token.literal);
+                break;
+            case DateFormat::ERA:
+                write_Ee(era, token.uppercase, out);
+                break;
+            case DateFormat::YEAR:
+                write_Yy(year, token.uppercase, out);
+                break;
+            case DateFormat::MONTH:
+                write_Mm(month, token.uppercase, out);
+                break;
+            case DateFormat::DAY:
+                write_Dd(day, token.uppercase, out);
+                break;
+            case DateFormat::WEEKDAY:
+                write_Ww(day_of_week, token.uppercase, out);
+                break;
+        }
+    }
+    return out.size();
+}
+
 void GregorianCalendar::from_serial_date(int serial_date,
         int& day_of_week) const {
     day_of_week = serial_date >= -4 ?
             (serial_date + 4) % 7 : (serial_date + 5) % 7 + 6;
 }
 
+/*
+ * @brief Batch form of to_serial_date(era, year, month, day).
+ * @note The loop body has no data-dependent branch and no call: the
+ *       validity of every element is folded into one flag (invalid elements
+ *       are converted as 1970-01-01 meanwhile), so the compiler can
+ *       vectorize it. If the flag is set, the elements are converted again
+ *       one by one, which reports the first invalid one.
+ * @note [complexity]: O(count)
+ */
+void GregorianCalendar::to_serial_dates(const int* eras, const int* years,
+        const int* months, const int* days, std::size_t count,
+        int* serial_dates) const {
+    const int last_day[13] = {
+        0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+    };
+    int invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const int era = eras[i];
+        const int month = months[i];
+        const int day = days[i];
+        const int year = era == BC ? 1 - years[i] : years[i];
+        // A multiple of 4 is a multiple of 100 (400) exactly when it is
+        // also one of 25 (16 and 25).
+        const int leap = ((year & 3) == 0)
+            & ((year % 25 != 0) | ((year & 15) == 0));
+        const int month_ok = (month >= 1) & (month <= 12);
+        const int safe_month = month_ok ? month : 1;
+        const int ok = (era >= 0) & (era < END_OF_ERA) & (years[i] > 0)
+            & month_ok & (day >= 1)
+            & (day <= last_day[safe_month] + (leap & (safe_month == 2)));
+        invalid |= !ok;
+        serial_dates[i] = days_from_civil(ok ? year : 1970,
+            ok ? month : 1, ok ? day : 1);
+    }
+    if (invalid) {
+        for (std::size_t i = 0; i < count; ++i) {
+            serial_dates[i] = GregorianCalendar::to_serial_date(
+                eras[i], years[i], months[i], days[i]);
+        }
+    }
+}
+
+/*
+ * @brief Batch form of from_serial_date(serial_date, era, year, month, day).
+ * @note Hinnant's algorithm as in from_serial_date, written without
+ *       branches or calls (the conditionals are selects) so that the
+ *       compiler can vectorize the loop.
+ * @note [complexity]: O(count)
+ */
+void GregorianCalendar::from_serial_dates(const int* serial_dates,
+        std::size_t count,
+        int* eras, int* years, int* months, int* days) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        const int z = serial_dates[i] + 719468;
+        const int era_year = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned int doe
+            = static_cast<unsigned int>(z - era_year * 146097);
+        const unsigned int yoe = (doe - doe / 1460 + doe / 36524
+            - doe / 146096) / 365;
+        const unsigned int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned int mp = (5 * doy + 2) / 153;
+        const int month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        const int year = static_cast<int>(yoe) + era_year * 400
+            + (month <= 2);
+        days[i] = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+        months[i] = month;
+        eras[i] = year <= 0 ? BC : AD;
+        years[i] = year <= 0 ? 1 - year : year;
+    }
+}
+
 void GregorianCalendar::parse_formatted_date(const std::string& date_str,
     std::size_t pos,
     const char* format,
@@ -183,25 +467,18 @@ void GregorianCalendar::parse_formatted_date(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict) const {
     if (pos >= date_str.size() && !*format) {
         if (year_found && month_found && day_found) {
-            try {
-                int ret = to_serial_date(era, year, month, day);
-                if (!all_found) {
-                    serial = ret;
-                }
-            } catch (std::exception &e) {
+            if (!is_valid_date(era, year, month, day)) {
                 return;
             }
-            if (all_found) {
-                throw std::invalid_argument(
-                    "GregorianCalendar::parse_formatted_date failed: "
-                    "date_str is ambiguous");
+            if (match_count == 0) {
+                serial = to_serial_date(era, year, month, day);
             }
-            all_found = true;
+            ++match_count;  // more than one match: date_str is ambiguous
         }
         return;
     }
@@ -214,7 +491,7 @@ void GregorianCalendar::parse_formatted_date(const std::string& date_str,
             year, year_found,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -235,7 +512,7 @@ void GregorianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -252,7 +529,7 @@ void GregorianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -269,7 +546,7 @@ void GregorianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -286,7 +563,7 @@ void GregorianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -300,7 +577,7 @@ void GregorianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -319,7 +596,7 @@ void GregorianCalendar::parse_Ee(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -342,16 +619,12 @@ void GregorianCalendar::parse_Ee(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
         }
     }
-    throw std::invalid_argument(
-        "GregorianCalendar::parse_Ee failed: "
-        "era not found in date_str at position "
-        + toolbox::to_string(pos));
 }
 
 void GregorianCalendar::parse_Yy(const std::string& date_str,
@@ -361,7 +634,7 @@ void GregorianCalendar::parse_Yy(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -376,10 +649,7 @@ void GregorianCalendar::parse_Yy(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string year_str = date_str.substr(pos, num_len);
-            try {
-                year = toolbox::stoi(year_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, year)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -387,10 +657,10 @@ void GregorianCalendar::parse_Yy(const std::string& date_str,
                 year, true,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -399,10 +669,7 @@ void GregorianCalendar::parse_Yy(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string year_str = date_str.substr(pos, 2);
-        try {
-            year = toolbox::stoi(year_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, year)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -410,7 +677,7 @@ void GregorianCalendar::parse_Yy(const std::string& date_str,
             year, true,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -424,7 +691,7 @@ void GregorianCalendar::parse_Mm(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -439,10 +706,7 @@ void GregorianCalendar::parse_Mm(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string month_str = date_str.substr(pos, num_len);
-            try {
-                month = toolbox::stoi(month_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, month)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -450,10 +714,10 @@ void GregorianCalendar::parse_Mm(const std::string& date_str,
                 year, year_found,
                 month, true,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -462,10 +726,7 @@ void GregorianCalendar::parse_Mm(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string month_str = date_str.substr(pos, 2);
-        try {
-            month = toolbox::stoi(month_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, month)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -473,7 +734,7 @@ void GregorianCalendar::parse_Mm(const std::string& date_str,
             year, year_found,
             month, true,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -487,7 +748,7 @@ void GregorianCalendar::parse_Dd(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -502,10 +763,7 @@ void GregorianCalendar::parse_Dd(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string day_str = date_str.substr(pos, num_len);
-            try {
-                day = toolbox::stoi(day_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, day)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -513,10 +771,10 @@ void GregorianCalendar::parse_Dd(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, true,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -525,10 +783,7 @@ void GregorianCalendar::parse_Dd(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string day_str = date_str.substr(pos, 2);
-        try {
-            day = toolbox::stoi(day_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, day)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -536,7 +791,7 @@ void GregorianCalendar::parse_Dd(const std::string& date_str,
             year, year_found,
             month, month_found,
             day, true,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -560,7 +815,20 @@ int last_day_of_month(int year, int month) {
     return last_day[month - 1];
 }
 
-std::string to_string_Ee(int era, bool uppercase) {
+// Hinnant's algorithm (days_from_civil)
+// year is astronomical (1 B.C. == 0); month and day must already be valid.
+int days_from_civil(int year, int month, int day) {
+    year -= !!(month <= 2);
+    const int era_year = (year >= 0 ? year : year - 399) / 400;
+    const unsigned int yoe = static_cast<unsigned int>(year - era_year * 400);
+    const unsigned int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2)
+        / 5 + day - 1;
+    const unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era_year * 146097 + static_cast<int>(doe) - 719468;
+}
+
+
+void write_Ee(int era, bool uppercase, toolbox::DateBuffer& out) {
     const char* era_str_E[] = {
         /* [toolbox::GregorianCalendar::BC] = */ "B.C.",
         /* [toolbox::GregorianCalendar::AD] = */ "A.D.",
@@ -573,52 +841,46 @@ std::string to_string_Ee(int era, bool uppercase) {
         throw std::out_of_range(
             "to_string_Ee failed: Invalid era: " + toolbox::to_string(era));
     }
-    return uppercase ? era_str_E[era] : era_str_e[era];
+    out.append(uppercase ? era_str_E[era] : era_str_e[era]);
 }
 
-std::string to_string_Yy(int year, bool uppercase) {
+void write_Yy(int year, bool uppercase, toolbox::DateBuffer& out) {
     if (year < 0) {
         throw std::out_of_range("to_string_Yy failed: year must be positive");
     } else if (year == 0) {
         throw std::out_of_range("to_string_Yy failed: "
             "year 0 does not exist in Gregorian calendar");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << year;
+        out.append_number(year);
     } else {
-        oss << std::setw(2) << std::setfill('0') << (year % 100);
+        out.append_number(year % 100, 2);
     }
-    return oss.str();
 }
 
-std::string to_string_Mm(int month, bool uppercase) {
+void write_Mm(int month, bool uppercase, toolbox::DateBuffer& out) {
     if (month < 1 || month > 12) {
         throw std::out_of_range("to_string_Mm failed: month must be in 1..12");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << month;
+        out.append_number(month);
     } else {
-        oss << std::setw(2) << std::setfill('0') << month;
+        out.append_number(month, 2);
     }
-    return oss.str();
 }
 
-std::string to_string_Dd(int day, bool uppercase) {
+void write_Dd(int day, bool uppercase, toolbox::DateBuffer& out) {
     if (day < 1 || day > 31) {
         throw std::out_of_range("to_string_Dd failed: day must be in 1..31");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << day;
+        out.append_number(day);
     } else {
-        oss << std::setw(2) << std::setfill('0') << day;
+        out.append_number(day, 2);
     }
-    return oss.str();
 }
 
-std::string to_string_Ww(int day_of_week, bool uppercase) {
+void write_Ww(int day_of_week, bool uppercase, toolbox::DateBuffer& out) {
     const char* day_of_week_str_W[] = {
         "Sunday", "Monday", "Tuesday", "Wednesday",
         "Thursday", "Friday", "Saturday"
@@ -630,8 +892,43 @@ std::string to_string_Ww(int day_of_week, bool uppercase) {
     if (day_of_week < 0 || day_of_week > 6) {
         throw std::out_of_range("to_string_Ww: day_of_week must be in 0..6");
     }
-    return uppercase ?
-        day_of_week_str_W[day_of_week] : day_of_week_str_w[day_of_week];
+    out.append(uppercase ?
+        day_of_week_str_W[day_of_week] : day_of_week_str_w[day_of_week]);
+}
+
+std::string to_string_Ee(int era, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Ee(era, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Yy(int year, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Yy(year, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Mm(int month, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Mm(month, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Dd(int day, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Dd(day, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Ww(int day_of_week, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Ww(day_of_week, uppercase, out);
+    return std::string(out.data(), out.size());
 }
 
 }  // namespace
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 #include <ex00/calendar_system/ICalendarSystem.hpp>
@@ -17,12 +18,33 @@ class GregorianCalendar : public ICalendarSystem {
     int to_serial_date(int era, int year, int month, int day) const;
     int to_serial_date(const std::string& date_str,
         const char* format, bool strict) const;
+    int to_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict) const;
+    bool is_valid_date(int era, int year, int month, int day) const;
+    ParseResult parse_serial_date(const std::string& date_str,
+        const char* format, bool strict, int& serial_date) const;
+    ParseResult parse_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict, int& serial_date) const;
     void from_serial_date(int serial_date,
         int& era, int& year, int& month, int& day) const;
     void from_serial_date(int serial_date,
         std::string& date_str, const char* format) const;
+    void from_serial_date(int serial_date,
+        std::string& date_str, const DateFormat& format) const;
+    std::size_t from_serial_date(int serial_date,
+        char* buffer, std::size_t size, const DateFormat& format) const;
     void from_serial_date(int serial_date,
         int& day_of_week) const;  // 0=Sun, 1=Mon, ..., 6=Sat
+    void to_serial_dates(const int* eras, const int* years,
+        const int* months, const int* days, std::size_t count,
+        int* serial_dates) const;
+    void from_serial_dates(const int* serial_dates, std::size_t count,
+        int* eras, int* years, int* months, int* days) const;
+
+    static bool parse_iso_date(const std::string& date_str,
+        ParseResult& result, int& serial_date);
+    static bool parse_iso_date(const char* date_str, std::size_t size,
+        ParseResult& result, int& serial_date);
 
     enum Era {
         BC,
@@ -38,7 +60,7 @@ class GregorianCalendar : public ICalendarSystem {
         int& year, bool year_found,
         int& month, bool month_found,
         int& day, bool day_found,
-        bool& all_found,
+        int& match_count,
         int& serial,
         bool strict) const;
     void parse_Ee(const std::string& date_str,
@@ -48,7 +70,7 @@ class GregorianCalendar : public ICalendarSystem {
         int& year, bool year_found,
         int& month, bool month_found,
         int& day, bool day_found,
-        bool& all_found,
+        int& match_count,
         int& serial,
         bool strict) const;
     void parse_Yy(const std::string& date_str,
@@ -58,7 +80,7 @@ class GregorianCalendar : public ICalendarSystem {
         int& year, bool year_found,
         int& month, bool month_found,
         int& day, bool day_found,
-        bool& all_found,
+        int& match_count,
         int& serial,
         bool strict) const;
     void parse_Mm(const std::string& date_str,
@@ -68,7 +90,7 @@ class GregorianCalendar : public ICalendarSystem {
         int& year, bool year_found,
         int& month, bool month_found,
         int& day, bool day_found,
-        bool& all_found,
+        int& match_count,
         int& serial,
         bool strict) const;
     void parse_Dd(const std::string& date_str,
@@ -78,7 +100,7 @@ class GregorianCalendar : public ICalendarSystem {
         int& year, bool year_found,
         int& month, bool month_found,
         int& day, bool day_found,
-        bool& all_found,
+        int& match_count,
         int& serial,
         bool strict) const;
 };
@@ -1,9 +1,30 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
+#include <ex00/calendar_system/DateFormat.hpp>
+
 namespace toolbox {
 
+/**
+ * @brief Outcome of ICalendarSystem::parse_serial_date, the non-throwing
+ * form of to_serial_date.
+ *
+ * message is a string literal (nothing allocated, nothing to free): the
+ * what() of the exception to_serial_date throws for the same input.
+ */
+struct ParseResult {
+    enum Status {
+        OK,
+        NO_MATCH,   // not a date of the format, or no such date
+        AMBIGUOUS   // matches the format in more than one way
+    };
+
+    Status status;
+    const char* message;  // "" if OK
+};
+
 class ICalendarSystem {
  public:
     virtual ~ICalendarSystem() {}
@@ -12,12 +33,51 @@ class ICalendarSystem {
         int year, int month, int day) const = 0;
     virtual int to_serial_date(const std::string& date_str,
         const char* format, bool strict = true) const = 0;
+    virtual int to_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict = true) const = 0;
+
+    /*
+     * @brief Non-throwing forms of to_serial_date, for input that is
+     *        expected to be malformed now and then: serial_date is set only
+     *        if the result is ParseResult::OK.
+     * @throw std::invalid_argument only if format itself is unusable (null,
+     *        or a field given twice); never because of date_str.
+     */
+    virtual bool is_valid_date(int era,
+        int year, int month, int day) const = 0;
+    virtual ParseResult parse_serial_date(const std::string& date_str,
+        const char* format, bool strict, int& serial_date) const = 0;
+    virtual ParseResult parse_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict, int& serial_date) const = 0;
+
     virtual void from_serial_date(int serial_date,
         int& era, int& year, int& month, int& day) const = 0;
     virtual void from_serial_date(int serial_date,
         std::string& date_str, const char* format) const = 0;
+    virtual void from_serial_date(int serial_date,
+        std::string& date_str, const DateFormat& format) const = 0;
+    // Allocation-free form of the above: writes the date and a '\0' into
+    // buffer[0, size) and returns its length; std::length_error if it does
+    // not fit.
+    virtual std::size_t from_serial_date(int serial_date,
+        char* buffer, std::size_t size, const DateFormat& format) const = 0;
     virtual void from_serial_date(int serial_date,
         int& day_of_week) const = 0;  // 0=Sun, 1=Mon, ..., 6=Sat
+
+    /*
+     * @brief Batch forms of to_serial_date(era, year, month, day) and
+     *        from_serial_date(serial_date, era, year, month, day): element i
+     *        of the output arrays is the conversion of element i of the
+     *        input arrays, for i in [0, count).
+     * @throw The same exception as the single conversion, for the first
+     *        element that cannot be converted; the outputs are unspecified
+     *        in that case.
+     */
+    virtual void to_serial_dates(const int* eras, const int* years,
+        const int* months, const int* days, std::size_t count,
+        int* serial_dates) const = 0;
+    virtual void from_serial_dates(const int* serial_dates, std::size_t count,
+        int* eras, int* years, int* months, int* days) const = 0;
 };
 
 }  // namespace toolbox
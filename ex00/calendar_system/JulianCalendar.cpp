@@ -9,12 +9,52 @@
 #include <cctype>
 #include <algorithm>
 
+#include <ex00/calendar_system/YearTable.hpp>
 #include <toolbox/string.hpp>
+#include <ex00/calendar_system/DateBuffer.hpp>
 
 namespace {
 
+// What parse_serial_date reports; to_serial_date throws the same text.
+const toolbox::ParseResult parse_ok = {toolbox::ParseResult::OK, ""};
+const toolbox::ParseResult no_match = {toolbox::ParseResult::NO_MATCH,
+    "JulianCalendar::to_serial_date failed: "
+    "date_str does not match format"};
+const toolbox::ParseResult ambiguous = {toolbox::ParseResult::AMBIGUOUS,
+    "JulianCalendar::parse_formatted_date failed: "
+    "date_str is ambiguous"};
+
+// Years converted through the year table (45 BC, when the calendar was
+// introduced, to AD 3000); the others are computed.
+const int table_first_year = -44;
+const int table_last_year = 3000;
+const int days_before_month[] = {
+    0,    // dummy
+    0,    // January
+    31,   // February
+    59,   // March
+    90,   // April
+    120,  // May
+    151,  // June
+    181,  // July
+    212,  // August
+    243,  // September
+    273,  // October
+    304,  // November
+    334,  // December
+    365,  // end of year
+};
+
 bool is_leap(int year);
 int last_day_of_month(int year, int month);
+int year_start(int year);
+const toolbox::YearTable& year_table();
+void split_day_of_year(int day_of_year, bool leap, int& month, int& day);
+void write_Ee(int era, bool uppercase, toolbox::DateBuffer& out);
+void write_Yy(int year, bool uppercase, toolbox::DateBuffer& out);
+void write_Mm(int month, bool uppercase, toolbox::DateBuffer& out);
+void write_Dd(int day, bool uppercase, toolbox::DateBuffer& out);
+void write_Ww(int day_of_week, bool uppercase, toolbox::DateBuffer& out);
 std::string to_string_Ee(int era, bool uppercase);
 std::string to_string_Yy(int year, bool uppercase);
 std::string to_string_Mm(int month, bool uppercase);
@@ -42,23 +82,6 @@ JulianCalendar::~JulianCalendar() {
 
 int JulianCalendar::to_serial_date(
     int era, int year, int month, int day) const {
-    const int julian_bc45_1_1_serial = -735601;
-    const int days_before_month[] = {
-        0,    // dummy
-        0,    // January
-        31,   // February
-        59,   // March
-        90,   // April
-        120,  // May
-        151,  // June
-        181,  // July
-        212,  // August
-        243,  // September
-        273,  // October
-        304,  // November
-        334,  // December
-    };
-
     if (era < 0 || era >= JulianCalendar::END_OF_ERA) {
         throw std::out_of_range(
             "JulianCalendar::to_serial_date failed: Invalid era");
@@ -79,20 +102,29 @@ int JulianCalendar::to_serial_date(
             "JulianCalendar::to_serial_date failed: day is out of range");
     }
 
-    int count_leaps = 0;
-    if (year >= 8) {
-        count_leaps = 12 + (year - 1) / 4;
-    } else if (year <= -44) {
-        count_leaps = (year + 44) / 4;
-    } else if (year >= -43 && year <= -7) {
-        count_leaps = (year + 45) / 3;
-    } else {
-        count_leaps = 13;
+    const toolbox::YearTable& table = year_table();
+    if (table.contains(year)) {
+        return table.year_start(year) + days_before_month[month]
+            + !!(month > 2 && table.is_leap(year)) + day - 1;
     }
-    int total_days = (year + 44) * 365 + count_leaps;
-    total_days += days_before_month[month] + !!(month > 2 && is_leap(year));
-    total_days += day - 1;
-    return total_days + julian_bc45_1_1_serial;
+    return year_start(year) + days_before_month[month]
+        + !!(month > 2 && is_leap(year)) + day - 1;
+}
+
+/*
+ * @brief Whether to_serial_date(era, year, month, day) has a result (rather
+ *        than throwing std::out_of_range).
+ */
+bool JulianCalendar::is_valid_date(
+    int era, int year, int month, int day) const {
+    if (era < 0 || era >= JulianCalendar::END_OF_ERA || year <= 0
+        || month < 1 || month > 12) {
+        return false;
+    }
+    if (era == JulianCalendar::BC) {
+        year = 1 - year;
+    }
+    return day >= 1 && day <= last_day_of_month(year, month);
 }
 
 int JulianCalendar::to_serial_date(
@@ -101,27 +133,91 @@ int JulianCalendar::to_serial_date(
         throw std::invalid_argument("JulianCalendar::to_serial_date failed: "
             "format is null");
     }
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
+    }
+    return serial;
+}
+
+/*
+ * @brief Non-throwing form of to_serial_date(date_str, format, strict).
+ * @return NO_MATCH or AMBIGUOUS (and serial_date unchanged) for the inputs
+ *         to_serial_date rejects.
+ * @throw std::invalid_argument if format is null or gives a field twice.
+ */
+ParseResult JulianCalendar::parse_serial_date(
+        const std::string& date_str, const char* format, bool strict,
+        int& serial_date) const {
+    if (!format) {
+        throw std::invalid_argument(
+            "JulianCalendar::parse_serial_date failed: "
+            "format is null");
+    }
     int era = toolbox::JulianCalendar::AD;
     int year = 0, month = 0, day = 0;
-    bool all_found = false;
+    int match_count = 0;
     int serial = 0;
     parse_formatted_date(date_str, 0, format,
         era, false,
         year, false,
         month, false,
         day, false,
-        all_found,
+        match_count,
         serial,
         strict);
-    if (!all_found) {
-        throw std::invalid_argument("JulianCalendar::to_serial_date failed: "
-            "date_str does not match format");
+    if (match_count != 1) {
+        return match_count == 0 ? no_match : ambiguous;
+    }
+    serial_date = serial;
+    return parse_ok;
+}
+
+int JulianCalendar::to_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict) const {
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
     }
     return serial;
 }
 
+/*
+ * @brief Same as the const char* overload, but with a precompiled format.
+ * @note Numeric layouts are sliced by position and validated once; any other
+ *       format (or a date string the positional split does not apply to)
+ *       goes through the generic parser.
+ */
+ParseResult JulianCalendar::parse_serial_date(
+        const std::string& date_str, const DateFormat& format, bool strict,
+        int& serial_date) const {
+    int year, month, day;
+    if (format.has_numeric_layout()
+        && format.extract_numeric_fields(date_str, year, month, day)) {
+        if (!is_valid_date(AD, year, month, day)) {
+            return no_match;
+        }
+        serial_date = to_serial_date(AD, year, month, day);
+        return parse_ok;
+    }
+    return parse_serial_date(date_str, format.c_str(), strict, serial_date);
+}
+
 void JulianCalendar::from_serial_date(
     int serial_date, int& era, int& year, int& month, int& day) const {
+    int doy;
+    if (year_table().find(serial_date, year, doy)) {
+        split_day_of_year(doy, year_table().is_leap(year), month, day);
+        era = year <= 0 ? JulianCalendar::BC : JulianCalendar::AD;
+        if (year <= 0) {
+            year = 1 - year;
+        }
+        return;
+    }
     const int julian_bc45_3_1_serial = -735541;  // BC45/3/1(Julian)
     const int julian_bc7_3_1_serial = -721659;  // BC7/3/1(Julian)
     const int julian_ad4_3_1_serial = -717279;  // AD4/3/1(Julian)
@@ -221,12 +317,112 @@ void JulianCalendar::from_serial_date(int serial_date,
     date_str = ss.str();
 }
 
+void JulianCalendar::from_serial_date(int serial_date,
+        std::string& date_str, const DateFormat& format) const {
+    int era, year, month, day;
+    from_serial_date(serial_date, era, year, month, day);
+    int day_of_week;
+    from_serial_date(serial_date, day_of_week);
+    std::string result;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const DateFormat::Token& token = format[i];
+        switch (token.field) {
+            case DateFormat::LITERAL:
+                result += token.literal;
+                break;
+            case DateFormat::ERA:
+                result += to_string_Ee(era, token.uppercase);
+                break;
+            case DateFormat::YEAR:
+                result += to_string_Yy(year, token.uppercase);
+                break;
+            case DateFormat::MONTH:
+                result += to_string_Mm(month, token.uppercase);
+                break;
+            case DateFormat::DAY:
+                result += to_string_Dd(day, token.uppercase);
+                break;
+            case DateFormat::WEEKDAY:
+                result += to_string_Ww(day_of_week, token.uppercase);
+                break;
+        }
+    }
+    date_str.swap(result);
+}
+
+/*
+ * @brief Formats serial_date into buffer[0, size), followed by a '\0',
+ *        without allocating.
+ * @return The length of the formatted date ('\0' excluded).
+ * @throw std::length_error if the date and its '\0' do not fit in size
+ *        bytes (see DATE_BUFFER_SIZE); the contents of buffer are then
+ *        unspecified.
+ */
+std::size_t JulianCalendar::from_serial_date(int serial_date,
+        char* buffer, std::size_t size, const DateFormat& format) const {
+    int era, year, month, day;
+    from_serial_date(serial_date, era, year, month, day);
+    int day_of_week;
+    from_serial_date(serial_date, day_of_week);
+    DateBuffer out(buffer, size);
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const DateFormat::Token& token = format[i];
+        switch (token.field) {
+            case DateFormat::LITERAL:
+                out.append(token.literal);
+                break;
+            case DateFormat::ERA:
+                write_Ee(era, token.uppercase, out);
+                break;
+            case DateFormat::YEAR:
+                write_Yy(year, token.uppercase, out);
+                break;
+            case DateFormat::MONTH:
+                write_Mm(month, token.uppercase, out);
+                break;
+            case DateFormat::DAY:
+                write_Dd(day, token.uppercase, out);
+                break;
+            case DateFormat::WEEKDAY:
+                write_Ww(day_of_week, token.uppercase, out);
+                break;
+        }
+    }
+    return out.size();
+}
+
 void JulianCalendar::from_serial_date(int serial_date,
         int& day_of_week) const {
     day_of_week = serial_date >= -4 ?
             (serial_date + 4) % 7 : (serial_date + 5) % 7 + 6;
 }
 
+/*
+ * @brief Batch form of to_serial_date(era, year, month, day).
+ * @note The single conversion is called without virtual dispatch.
+ */
+void JulianCalendar::to_serial_dates(const int* eras, const int* years,
+        const int* months, const int* days, std::size_t count,
+        int* serial_dates) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        serial_dates[i] = JulianCalendar::to_serial_date(
+            eras[i], years[i], months[i], days[i]);
+    }
+}
+
+/*
+ * @brief Batch form of from_serial_date(serial_date, era, year, month, day).
+ * @note The single conversion is called without virtual dispatch.
+ */
+void JulianCalendar::from_serial_dates(const int* serial_dates,
+        std::size_t count,
+        int* eras, int* years, int* months, int* days) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        JulianCalendar::from_serial_date(
+            serial_dates[i], eras[i], years[i], months[i], days[i]);
+    }
+}
+
 void JulianCalendar::parse_formatted_date(const std::string& date_str,
     std::size_t pos,
     const char* format,
@@ -234,25 +430,18 @@ void JulianCalendar::parse_formatted_date(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict) const {
     if (pos >= date_str.size() && !*format) {
         if (year_found && month_found && day_found) {
-            try {
-                int ret = to_serial_date(era, year, month, day);
-                if (!all_found) {
-                    serial = ret;
-                }
-            } catch (std::exception &e) {
+            if (!is_valid_date(era, year, month, day)) {
                 return;
             }
-            if (all_found) {
-                throw std::invalid_argument(
-                    "JulianCalendar::parse_formatted_date failed: "
-                    "date_str is ambiguous");
+            if (match_count == 0) {
+                serial = to_serial_date(era, year, month, day);
             }
-            all_found = true;
+            ++match_count;  // more than one match: date_str is ambiguous
         }
         return;
     }
@@ -265,7 +454,7 @@ void JulianCalendar::parse_formatted_date(const std::string& date_str,
             year, year_found,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -286,7 +475,7 @@ void JulianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -303,7 +492,7 @@ void JulianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -320,7 +509,7 @@ void JulianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -337,7 +526,7 @@ void JulianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -351,7 +540,7 @@ void JulianCalendar::parse_formatted_date(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -370,7 +559,7 @@ void JulianCalendar::parse_Ee(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -393,15 +582,12 @@ void JulianCalendar::parse_Ee(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
         }
     }
-    throw std::invalid_argument("JulianCalendar::parse_Ee failed: "
-        "era not found in date_str at position "
-        + toolbox::to_string(pos));
 }
 
 void JulianCalendar::parse_Yy(const std::string& date_str,
@@ -411,7 +597,7 @@ void JulianCalendar::parse_Yy(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -426,10 +612,7 @@ void JulianCalendar::parse_Yy(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string year_str = date_str.substr(pos, num_len);
-            try {
-                year = toolbox::stoi(year_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, year)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -437,10 +620,10 @@ void JulianCalendar::parse_Yy(const std::string& date_str,
                 year, true,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -449,10 +632,7 @@ void JulianCalendar::parse_Yy(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string year_str = date_str.substr(pos, 2);
-        try {
-            year = toolbox::stoi(year_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, year)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -460,7 +640,7 @@ void JulianCalendar::parse_Yy(const std::string& date_str,
             year, true,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -474,7 +654,7 @@ void JulianCalendar::parse_Mm(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -489,10 +669,7 @@ void JulianCalendar::parse_Mm(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string month_str = date_str.substr(pos, num_len);
-            try {
-                month = toolbox::stoi(month_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, month)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -500,10 +677,10 @@ void JulianCalendar::parse_Mm(const std::string& date_str,
                 year, year_found,
                 month, true,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -512,10 +689,7 @@ void JulianCalendar::parse_Mm(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string month_str = date_str.substr(pos, 2);
-        try {
-            month = toolbox::stoi(month_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, month)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -523,7 +697,7 @@ void JulianCalendar::parse_Mm(const std::string& date_str,
             year, year_found,
             month, true,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -537,7 +711,7 @@ void JulianCalendar::parse_Dd(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -552,10 +726,7 @@ void JulianCalendar::parse_Dd(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string day_str = date_str.substr(pos, num_len);
-            try {
-                day = toolbox::stoi(day_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, day)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -563,10 +734,10 @@ void JulianCalendar::parse_Dd(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, true,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -575,10 +746,7 @@ void JulianCalendar::parse_Dd(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string day_str = date_str.substr(pos, 2);
-        try {
-            day = toolbox::stoi(day_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, day)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -586,7 +754,7 @@ void JulianCalendar::parse_Dd(const std::string& date_str,
             year, year_found,
             month, month_found,
             day, true,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -597,8 +765,9 @@ void JulianCalendar::parse_Dd(const std::string& date_str,
 
 namespace {
 
+// 45 BC (year -44) has no leap day: year_start does not count one for it.
 bool is_leap(int year) {
-    return ((year >= 8 || year <= -44)  && year % 4 == 0)
+    return ((year >= 8 || year < -44) && year % 4 == 0)
         || (year >= -43 && year <= -7 && (year - 2) % 3 == 0);
 }
 
@@ -612,7 +781,49 @@ int last_day_of_month(int year, int month) {
     return last_day[month - 1];
 }
 
-std::string to_string_Ee(int era, bool uppercase) {
+int year_start(int year) {
+    const int julian_bc45_1_1_serial = -735601;
+    int count_leaps = 0;
+    if (year >= 8) {
+        count_leaps = 12 + (year - 1) / 4;
+    } else if (year <= -44) {
+        count_leaps = (year + 44) / 4;
+    } else if (year >= -43 && year <= -7) {
+        count_leaps = (year + 45) / 3;
+    } else {
+        count_leaps = 13;
+    }
+    return (year + 44) * 365 + count_leaps + julian_bc45_1_1_serial;
+}
+
+/*
+ * @brief Year starts of years table_first_year..table_last_year, built on
+ *        first use.
+ * @note [complexity]: O(1) after the first call
+ */
+const toolbox::YearTable& year_table() {
+    static const toolbox::YearTable table(table_first_year, table_last_year,
+        year_start);
+    return table;
+}
+
+// Splits a 0-based day of the year into a month and a day of the month.
+void split_day_of_year(int day_of_year, bool leap, int& month, int& day) {
+    if (leap && day_of_year >= 59) {
+        if (day_of_year == 59) {
+            month = 2;
+            day = 29;
+            return;
+        }
+        --day_of_year;
+    }
+    // day_of_year / 32 is the month or the one before it.
+    month = day_of_year / 32 + 1;
+    month += (day_of_year >= days_before_month[month + 1]);
+    day = day_of_year - days_before_month[month] + 1;
+}
+
+void write_Ee(int era, bool uppercase, toolbox::DateBuffer& out) {
     const char* era_str_E[] = {
         /* [toolbox::JulianCalendar::BC] = */ "B.C.",
         /* [toolbox::JulianCalendar::AD] = */ "A.D.",
@@ -625,50 +836,44 @@ std::string to_string_Ee(int era, bool uppercase) {
         throw std::out_of_range(
             "to_string_Ee failed: Invalid era: " + toolbox::to_string(era));
     }
-    return uppercase ? era_str_E[era] : era_str_e[era];
+    out.append(uppercase ? era_str_E[era] : era_str_e[era]);
 }
 
-std::string to_string_Yy(int year, bool uppercase) {
+void write_Yy(int year, bool uppercase, toolbox::DateBuffer& out) {
     if (year <= 0) {
         throw std::out_of_range("to_string_Yy failed: "
             "year must be positive and not zero");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << year;
+        out.append_number(year);
     } else {
-        oss << std::setw(2) << std::setfill('0') << (year % 100);
+        out.append_number(year % 100, 2);
     }
-    return oss.str();
 }
 
-std::string to_string_Mm(int month, bool uppercase) {
+void write_Mm(int month, bool uppercase, toolbox::DateBuffer& out) {
     if (month < 1 || month > 12) {
         throw std::out_of_range("to_string_Mm failed: month must be in 1..12");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << month;
+        out.append_number(month);
     } else {
-        oss << std::setw(2) << std::setfill('0') << month;
+        out.append_number(month, 2);
     }
-    return oss.str();
 }
 
-std::string to_string_Dd(int day, bool uppercase) {
+void write_Dd(int day, bool uppercase, toolbox::DateBuffer& out) {
     if (day < 1 || day > 31) {
         throw std::out_of_range("to_string_Dd failed: day must be in 1..31");
     }
-    std::ostringstream oss;
     if (uppercase) {
-        oss << day;
+        out.append_number(day);
     } else {
-        oss << std::setw(2) << std::setfill('0') << day;
+        out.append_number(day, 2);
     }
-    return oss.str();
 }
 
-std::string to_string_Ww(int day_of_week, bool uppercase) {
+void write_Ww(int day_of_week, bool uppercase, toolbox::DateBuffer& out) {
     const char* day_of_week_str_W[] = {
         "Sunday", "Monday", "Tuesday", "Wednesday",
         "Thursday", "Friday", "Saturday"
@@ -680,8 +885,43 @@ std::string to_string_Ww(int day_of_week, bool uppercase) {
     if (day_of_week < 0 || day_of_week > 6) {
         throw std::out_of_range("to_string_Ww: day_of_week must be in 0..6");
     }
-    return uppercase ?
-        day_of_week_str_W[day_of_week] : day_of_week_str_w[day_of_week];
+    out.append(uppercase ?
+        day_of_week_str_W[day_of_week] : day_of_week_str_w[day_of_week]);
+}
+
+std::string to_string_Ee(int era, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Ee(era, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Yy(int year, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Yy(year, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Mm(int month, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Mm(month, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Dd(int day, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Dd(day, uppercase, out);
+    return std::string(out.data(), out.size());
+}
+
+std::string to_string_Ww(int day_of_week, bool uppercase) {
+    char buffer[toolbox::DATE_BUFFER_SIZE];
+    toolbox::DateBuffer out(buffer, sizeof(buffer));
+    write_Ww(day_of_week, uppercase, out);
+    return std::string(out.data(), out.size());
 }
 
 }  // namespace
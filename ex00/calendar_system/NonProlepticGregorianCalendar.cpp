@@ -9,6 +9,51 @@
 
 #include <toolbox/string.hpp>
 #include <ex00/calendar_system/GregorianCalendar.hpp>
+#include <ex00/calendar_system/YearTable.hpp>
+
+namespace {
+
+// What parse_serial_date reports; to_serial_date throws the same text.
+const toolbox::ParseResult parse_ok = {toolbox::ParseResult::OK, ""};
+const toolbox::ParseResult no_match = {toolbox::ParseResult::NO_MATCH,
+    "NonProlepticGregorianCalendar::to_serial_date failed: "
+    "Something went wrong while parsing date_str"};
+const toolbox::ParseResult ambiguous = {toolbox::ParseResult::AMBIGUOUS,
+    "NonProlepticGregorianCalendar::parse_formatted_date failed: "
+    "date_str is ambiguous"};
+
+// First day of the calendar: 1582-10-15 in (proleptic) Gregorian calendar.
+const int reform_serial = -141427;
+
+// Years converted through the year table (the Gregorian reform to AD 3000);
+// the others are left to GregorianCalendar.
+const int table_first_year = 1582;
+const int table_last_year = 3000;
+const int days_before_month[] = {
+    0,    // dummy
+    0,    // January
+    31,   // February
+    59,   // March
+    90,   // April
+    120,  // May
+    151,  // June
+    181,  // July
+    212,  // August
+    243,  // September
+    273,  // October
+    304,  // November
+    334,  // December
+    365,  // end of year
+};
+
+toolbox::GregorianCalendar gregorian;
+
+int last_day_of_month(bool leap, int month);
+int year_start(int year);
+const toolbox::YearTable& year_table();
+void split_day_of_year(int day_of_year, bool leap, int& month, int& day);
+
+}  // namespace
 
 namespace toolbox {
 
@@ -31,12 +76,30 @@ NonProlepticGregorianCalendar::~NonProlepticGregorianCalendar() {
 
 int NonProlepticGregorianCalendar::to_serial_date(int era,
     int year, int month, int day) const {
-    GregorianCalendar gc;
-    int serial = gc.to_serial_date(era, year, month, day);
+    const YearTable& table = year_table();
+    int serial;
+    if (era == AD && table.contains(year) && month >= 1 && month <= 12
+        && day >= 1 && day <= last_day_of_month(table.is_leap(year), month)) {
+        serial = table.year_start(year) + days_before_month[month]
+            + !!(month > 2 && table.is_leap(year)) + day - 1;
+    } else {
+        // Out of the table, or invalid: GregorianCalendar reports the error.
+        serial = gregorian.to_serial_date(era, year, month, day);
+    }
     validate_serial_date(serial);
     return serial;
 }
 
+/*
+ * @brief Whether to_serial_date(era, year, month, day) has a result (rather
+ *        than throwing std::out_of_range).
+ */
+bool NonProlepticGregorianCalendar::is_valid_date(int era,
+    int year, int month, int day) const {
+    return gregorian.is_valid_date(era, year, month, day)
+        && gregorian.to_serial_date(era, year, month, day) >= reform_serial;
+}
+
 int NonProlepticGregorianCalendar::to_serial_date(const std::string& date_str,
     const char* format, bool strict) const {
     if (!format) {
@@ -44,52 +107,147 @@ int NonProlepticGregorianCalendar::to_serial_date(const std::string& date_str,
             "NonProlepticGregorianCalendar::to_serial_date failed: "
             "format is null");
     }
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
+    }
+    return serial;
+}
+
+/*
+ * @brief Non-throwing form of to_serial_date(date_str, format, strict).
+ * @return NO_MATCH or AMBIGUOUS (and serial_date unchanged) for the inputs
+ *         to_serial_date rejects.
+ * @throw std::invalid_argument if format is null or gives a field twice.
+ */
+ParseResult NonProlepticGregorianCalendar::parse_serial_date(
+        const std::string& date_str, const char* format, bool strict,
+        int& serial_date) const {
+    if (!format) {
+        throw std::invalid_argument(
+            "NonProlepticGregorianCalendar::parse_serial_date failed: "
+            "format is null");
+    }
     int era = toolbox::NonProlepticGregorianCalendar::AD;
     int year = 0, month = 0, day = 0;
-    bool all_found = false;
+    int match_count = 0;
     int serial = 0;
     parse_formatted_date(date_str, 0, format,
         era, false,
         year, false,
         month, false,
         day, false,
-        all_found,
+        match_count,
         serial,
         strict);
-    if (!all_found) {
-        throw std::invalid_argument(
-            "NonProlepticGregorianCalendar::to_serial_date failed: "
-            "Something went wrong while parsing date_str");
+    if (match_count != 1) {
+        return match_count == 0 ? no_match : ambiguous;
+    }
+    serial_date = serial;
+    return parse_ok;
+}
+
+int NonProlepticGregorianCalendar::to_serial_date(const std::string& date_str,
+        const DateFormat& format, bool strict) const {
+    int serial = 0;
+    const ParseResult result = parse_serial_date(date_str, format, strict,
+        serial);
+    if (result.status != ParseResult::OK) {
+        throw std::invalid_argument(result.message);
     }
     return serial;
 }
 
+/*
+ * @brief Same as the const char* overload, but with a precompiled format.
+ * @note Numeric layouts are sliced by position and validated once; any other
+ *       format (or a date string the positional split does not apply to)
+ *       goes through the generic parser.
+ */
+ParseResult NonProlepticGregorianCalendar::parse_serial_date(
+        const std::string& date_str, const DateFormat& format, bool strict,
+        int& serial_date) const {
+    int year, month, day;
+    if (format.has_numeric_layout()
+        && format.extract_numeric_fields(date_str, year, month, day)) {
+        if (!is_valid_date(AD, year, month, day)) {
+            return no_match;
+        }
+        serial_date = to_serial_date(AD, year, month, day);
+        return parse_ok;
+    }
+    return parse_serial_date(date_str, format.c_str(), strict, serial_date);
+}
+
 void NonProlepticGregorianCalendar::from_serial_date(int serial_date,
     int& era, int& year, int& month, int& day) const {
     validate_serial_date(serial_date);
-    GregorianCalendar gc;
-    gc.from_serial_date(serial_date, era, year, month, day);
+    int doy;
+    if (year_table().find(serial_date, year, doy)) {
+        split_day_of_year(doy, year_table().is_leap(year), month, day);
+        era = AD;
+        return;
+    }
+    gregorian.from_serial_date(serial_date, era, year, month, day);
 }
 
 void NonProlepticGregorianCalendar::from_serial_date(int serial_date,
     std::string& date_str, const char* format) const {
     validate_serial_date(serial_date);
-    GregorianCalendar gc;
-    gc.from_serial_date(serial_date, date_str, format);
+    gregorian.from_serial_date(serial_date, date_str, format);
+}
+
+void NonProlepticGregorianCalendar::from_serial_date(int serial_date,
+    std::string& date_str, const DateFormat& format) const {
+    validate_serial_date(serial_date);
+    gregorian.from_serial_date(serial_date, date_str, format);
+}
+
+std::size_t NonProlepticGregorianCalendar::from_serial_date(int serial_date,
+    char* buffer, std::size_t size, const DateFormat& format) const {
+    validate_serial_date(serial_date);
+    return gregorian.from_serial_date(serial_date, buffer, size, format);
 }
 
 void NonProlepticGregorianCalendar::from_serial_date(int serial_date,
     int& day_of_week) const {
     validate_serial_date(serial_date);
-    GregorianCalendar gc;
-    gc.from_serial_date(serial_date, day_of_week);
+    gregorian.from_serial_date(serial_date, day_of_week);
+}
+
+/*
+ * @brief Batch form of to_serial_date(era, year, month, day).
+ * @note The single conversion is called without virtual dispatch.
+ */
+void NonProlepticGregorianCalendar::to_serial_dates(
+        const int* eras, const int* years,
+        const int* months, const int* days, std::size_t count,
+        int* serial_dates) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        serial_dates[i] = NonProlepticGregorianCalendar::to_serial_date(
+            eras[i], years[i], months[i], days[i]);
+    }
+}
+
+/*
+ * @brief Batch form of from_serial_date(serial_date, era, year, month, day).
+ * @note Once every date is known to be after the reform, the dates are
+ *       those of the proleptic calendar and its batch loop does the rest.
+ */
+void NonProlepticGregorianCalendar::from_serial_dates(
+        const int* serial_dates, std::size_t count,
+        int* eras, int* years, int* months, int* days) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        validate_serial_date(serial_dates[i]);
+    }
+    gregorian.from_serial_dates(serial_dates, count, eras, years, months, days);
 }
 
 void NonProlepticGregorianCalendar::validate_serial_date(
     int serial_date) const {
-    // -141427 is 1582-10-15 in Gregorian calendar
-    const int begin_gregorian = -141427;
-    if (serial_date < begin_gregorian) {
+    if (serial_date < reform_serial) {
         throw std::out_of_range(
             "NonProlepticGregorianCalendar::validate_serial_date failed: "
             "Dates before 1582-10-15 does not exist "
@@ -105,26 +263,18 @@ void NonProlepticGregorianCalendar::parse_formatted_date(
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict) const {
     if (pos >= date_str.size() && !*format) {
         if (year_found && month_found && day_found) {
-            try {
-                int ret = to_serial_date(era, year, month, day);
-                if (!all_found) {
-                    serial = ret;
-                }
-            } catch (std::exception &e) {
+            if (!is_valid_date(era, year, month, day)) {
                 return;
             }
-            if (all_found) {
-                throw std::invalid_argument(
-                    "NonProlepticGregorianCalendar::"
-                    "parse_formatted_date failed: "
-                    "date_str is ambiguous");
+            if (match_count == 0) {
+                serial = to_serial_date(era, year, month, day);
             }
-            all_found = true;
+            ++match_count;  // more than one match: date_str is ambiguous
         }
         return;
     }
@@ -137,7 +287,7 @@ void NonProlepticGregorianCalendar::parse_formatted_date(
             year, year_found,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -159,7 +309,7 @@ void NonProlepticGregorianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -177,7 +327,7 @@ void NonProlepticGregorianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -195,7 +345,7 @@ void NonProlepticGregorianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -213,7 +363,7 @@ void NonProlepticGregorianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -227,7 +377,7 @@ void NonProlepticGregorianCalendar::parse_formatted_date(
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
@@ -247,7 +397,7 @@ void NonProlepticGregorianCalendar::parse_Ee(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -270,16 +420,12 @@ void NonProlepticGregorianCalendar::parse_Ee(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
             return;
         }
     }
-    throw std::invalid_argument(
-        "NonProlepticGregorianCalendar::parse_Ee failed: "
-        "era not found in date_str at position "
-        + toolbox::to_string(pos));
 }
 
 void NonProlepticGregorianCalendar::parse_Yy(const std::string& date_str,
@@ -289,7 +435,7 @@ void NonProlepticGregorianCalendar::parse_Yy(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -304,10 +450,7 @@ void NonProlepticGregorianCalendar::parse_Yy(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string year_str = date_str.substr(pos, num_len);
-            try {
-                year = toolbox::stoi(year_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, year)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -315,10 +458,10 @@ void NonProlepticGregorianCalendar::parse_Yy(const std::string& date_str,
                 year, true,
                 month, month_found,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -327,10 +470,7 @@ void NonProlepticGregorianCalendar::parse_Yy(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string year_str = date_str.substr(pos, 2);
-        try {
-            year = toolbox::stoi(year_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, year)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -338,7 +478,7 @@ void NonProlepticGregorianCalendar::parse_Yy(const std::string& date_str,
             year, true,
             month, month_found,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -352,7 +492,7 @@ void NonProlepticGregorianCalendar::parse_Mm(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -367,10 +507,7 @@ void NonProlepticGregorianCalendar::parse_Mm(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string month_str = date_str.substr(pos, num_len);
-            try {
-                month = toolbox::stoi(month_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, month)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -378,10 +515,10 @@ void NonProlepticGregorianCalendar::parse_Mm(const std::string& date_str,
                 year, year_found,
                 month, true,
                 day, day_found,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -390,10 +527,7 @@ void NonProlepticGregorianCalendar::parse_Mm(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string month_str = date_str.substr(pos, 2);
-        try {
-            month = toolbox::stoi(month_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, month)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -401,7 +535,7 @@ void NonProlepticGregorianCalendar::parse_Mm(const std::string& date_str,
             year, year_found,
             month, true,
             day, day_found,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -415,7 +549,7 @@ void NonProlepticGregorianCalendar::parse_Dd(const std::string& date_str,
     int& year, bool year_found,
     int& month, bool month_found,
     int& day, bool day_found,
-    bool& all_found,
+    int& match_count,
     int& serial,
     bool strict
 ) const {
@@ -430,10 +564,7 @@ void NonProlepticGregorianCalendar::parse_Dd(const std::string& date_str,
             if (!std::isdigit(date_str[pos + num_len - 1])) {
                 break;
             }
-            std::string day_str = date_str.substr(pos, num_len);
-            try {
-                day = toolbox::stoi(day_str);
-            } catch (std::exception &e) {
+            if (!toolbox::parse_int(date_str.data() + pos, num_len, day)) {
                 continue;
             }
             parse_formatted_date(date_str, pos + num_len, format + 2,
@@ -441,10 +572,10 @@ void NonProlepticGregorianCalendar::parse_Dd(const std::string& date_str,
                 year, year_found,
                 month, month_found,
                 day, true,
-                all_found,
+                match_count,
                 serial,
                 strict);
-            if (all_found && !strict) {
+            if (match_count != 0 && !strict) {
                 return;
             }
         }
@@ -453,10 +584,7 @@ void NonProlepticGregorianCalendar::parse_Dd(const std::string& date_str,
         if (pos + 2 > date_str.size()) {
             return;
         }
-        std::string day_str = date_str.substr(pos, 2);
-        try {
-            day = toolbox::stoi(day_str);
-        } catch (std::exception &e) {
+        if (!toolbox::parse_int(date_str.data() + pos, 2, day)) {
             return;
         }
         parse_formatted_date(date_str, pos + 2, format + 2,
@@ -464,7 +592,7 @@ void NonProlepticGregorianCalendar::parse_Dd(const std::string& date_str,
             year, year_found,
             month, month_found,
             day, true,
-            all_found,
+            match_count,
             serial,
             strict);
         return;
@@ -472,3 +600,44 @@ void NonProlepticGregorianCalendar::parse_Dd(const std::string& date_str,
 }
 
 }  // namespace toolbox
+
+namespace {
+
+int last_day_of_month(bool leap, int month) {
+    return days_before_month[month + 1] - days_before_month[month]
+        + !!(leap && month == 2);
+}
+
+int year_start(int year) {
+    return gregorian.to_serial_date(toolbox::GregorianCalendar::AD,
+        year, 1, 1);
+}
+
+/*
+ * @brief Year starts of years table_first_year..table_last_year, built on
+ *        first use.
+ * @note [complexity]: O(1) after the first call
+ */
+const toolbox::YearTable& year_table() {
+    static const toolbox::YearTable table(table_first_year, table_last_year,
+        year_start);
+    return table;
+}
+
+// Splits a 0-based day of the year into a month and a day of the month.
+void split_day_of_year(int day_of_year, bool leap, int& month, int& day) {
+    if (leap && day_of_year >= 59) {
+        if (day_of_year == 59) {
+            month = 2;
+            day = 29;
+            return;
+        }
+        --day_of_year;
+    }
+    // day_of_year / 32 is the month or the one before it.
+    month = day_of_year / 32 + 1;
+    month += (day_of_year >= days_before_month[month + 1]);
+    day = day_of_year - days_before_month[month] + 1;
+}
+
+}  // namespace
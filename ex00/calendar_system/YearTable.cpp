@@ -0,0 +1,67 @@
+#include <ex00/calendar_system/YearTable.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+namespace toolbox {
+
+YearTable::YearTable() : _first_year(0), _starts(), _leaps() {
+}
+
+YearTable::YearTable(const YearTable& other)
+    : _first_year(other._first_year), _starts(other._starts),
+    _leaps(other._leaps) {
+}
+
+YearTable& YearTable::operator=(const YearTable& other) {
+    if (this != &other) {
+        _first_year = other._first_year;
+        _starts = other._starts;
+        _leaps = other._leaps;
+    }
+    return *this;
+}
+
+YearTable::~YearTable() {
+}
+
+/*
+ * @brief Tabulates the years first_year..last_year.
+ * @param year_start Serial date of the first day of a year (January 1st, 1
+ *        Vendemiaire, ...); called for last_year + 1 as well.
+ * @throw std::invalid_argument if the range is empty or year_start is not
+ *        increasing over it.
+ * @note [complexity]: O(last_year - first_year) calls, once per calendar
+ */
+YearTable::YearTable(int first_year, int last_year,
+        YearStartFunction year_start)
+    : _first_year(first_year), _starts(), _leaps() {
+    if (first_year > last_year || !year_start) {
+        throw std::invalid_argument("YearTable::YearTable failed: "
+            "invalid year range");
+    }
+    const std::size_t n = static_cast<std::size_t>(last_year - first_year) + 1;
+    _starts.reserve(n + 1);
+    _leaps.reserve(n);
+    for (std::size_t i = 0; i <= n; ++i) {
+        const int year = first_year + static_cast<int>(i);
+        _starts.push_back(year_start(year));
+        if (i != 0) {
+            if (_starts[i] <= _starts[i - 1]) {
+                throw std::invalid_argument("YearTable::YearTable failed: "
+                    "year starts are not increasing");
+            }
+            _leaps.push_back(_starts[i] - _starts[i - 1] > 365);
+        }
+    }
+}
+
+int YearTable::first_year() const {
+    return _first_year;
+}
+
+int YearTable::last_year() const {
+    return _first_year + static_cast<int>(_leaps.size()) - 1;
+}
+
+}  // namespace toolbox
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace toolbox {
+
+/**
+ * @brief Serial date of the first day and leap flag of every year of a
+ * contiguous range [first_year, last_year], computed once from a calendar's
+ * own arithmetic.
+ *
+ * A year is a leap year when it is longer than 365 days, so the flags always
+ * agree with the year starts.
+ *
+ * Converting a date of the range is then one lookup plus a day offset, and
+ * finding the year of a serial date is an estimate plus at most a step or
+ * two, whatever irregularities (leap rules, epochs) the calendar has.
+ * Years are the calendar's own, astronomical numbering (1 BC is 0).
+ */
+class YearTable {
+ public:
+    typedef int (*YearStartFunction)(int year);
+
+    YearTable();
+    YearTable(const YearTable& other);
+    YearTable& operator=(const YearTable& other);
+    ~YearTable();
+
+    YearTable(int first_year, int last_year, YearStartFunction year_start);
+
+    bool contains(int year) const;
+    int first_year() const;
+    int last_year() const;
+    int year_start(int year) const;
+    bool is_leap(int year) const;
+    bool find(int serial_date, int& year, int& day_of_year) const;
+
+ private:
+    int _first_year;
+    std::vector<int> _starts;           // one more entry than years
+    std::vector<unsigned char> _leaps;
+};
+
+// The lookups are inline: they sit on every conversion of the calendars.
+
+inline bool YearTable::contains(int year) const {
+    return year >= _first_year && static_cast<unsigned int>(year)
+        - static_cast<unsigned int>(_first_year) < _leaps.size();
+}
+
+// [constraint]: contains(year)
+inline int YearTable::year_start(int year) const {
+    return _starts[year - _first_year];
+}
+
+// [constraint]: contains(year)
+inline bool YearTable::is_leap(int year) const {
+    return _leaps[year - _first_year];
+}
+
+/*
+ * @brief Finds the year that serial_date falls in.
+ * @param day_of_year Receives the offset of serial_date from the first day
+ *        of that year (0-based).
+ * @return false if serial_date is outside the tabulated years.
+ * @note The year is first estimated from the Julian year length, which
+ *       is off by at most a step or two for any calendar of the table range.
+ * @note [complexity]: O(1)
+ */
+inline bool YearTable::find(int serial_date,
+        int& year, int& day_of_year) const {
+    if (_leaps.empty() || serial_date < _starts.front()
+        || serial_date >= _starts.back()) {
+        return false;
+    }
+    // 4 * days / 1461 is the number of 365.25-day years since the first
+    // start; a divisor known at compile time keeps this a multiplication.
+    std::size_t i = 4u * static_cast<unsigned int>(
+        serial_date - _starts.front()) / 1461u;
+    if (i >= _leaps.size()) {
+        i = _leaps.size() - 1;
+    }
+    while (_starts[i] > serial_date) {
+        --i;
+    }
+    while (_starts[i + 1] <= serial_date) {
+        ++i;
+    }
+    year = _first_year + static_cast<int>(i);
+    day_of_year = serial_date - _starts[i];
+    return true;
+}
+
+}  // namespace toolbox
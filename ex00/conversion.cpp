@@ -5,17 +5,262 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ex00/BasicDate.hpp>
+#include <ex00/ConversionReport.hpp>
+#include <ex00/DateRateCache.hpp>
+#include <ex00/RateStream.hpp>
+#include <ex00/calendar_system/DateBuffer.hpp>
+#include <ex00/calendar_system/GregorianCalendar.hpp>
+#include <toolbox/MappedFile.hpp>
 #include <toolbox/StepMark.hpp>
 
 namespace {
+typedef toolbox::BasicDate<toolbox::GregorianCalendar> GregorianDate;
+
+const toolbox::DateFormat date_format("%Y-%m-%d");
+
+// Inputs smaller than this are converted on the calling thread.
+const std::size_t parallel_min_bytes = 4 * 1024 * 1024;
+// Amount of input handed to a worker thread at a time.
+const std::size_t chunk_bytes = 4 * 1024 * 1024;
+// Numbers are written as std::ostream writes them by default.
+const int stream_precision = 6;
+
+// Where convert_line takes its rates from.
+class RateSource {
+ public:
+    virtual ~RateSource() {}
+
+    // Finds the rate in effect on serial_date; false if there is none.
+    virtual bool find(int serial_date, double &rate) = 0;
+    virtual bool empty() const = 0;
+};
+
+// Rates looked up in a loaded BitcoinExchange.
+class IndexedRates : public RateSource {
+ public:
+    explicit IndexedRates(const BitcoinExchange &btc);
+
+    bool find(int serial_date, double &rate);
+    bool empty() const;
+
+ private:
+    const BitcoinExchange &_btc;
+};
+
+// As-of join against a date-sorted data file, read alongside the input:
+// rows are consumed as the requested dates advance, so only the rate in
+// effect and the next row are held. A date earlier than the previous one
+// cannot be answered from the stream; the whole history is then loaded
+// into a BitcoinExchange, which answers every later request.
+class StreamedRates : public RateSource {
+ public:
+    StreamedRates(const std::string &data_filename, std::size_t rows);
+
+    bool find(int serial_date, double &rate);
+    bool empty() const;
+
+ private:
+    StreamedRates(const StreamedRates &other);
+    StreamedRates &operator=(const StreamedRates &other);
+
+    void load_index();
+
+    std::string _data_filename;
+    std::size_t _rows;  // valid rows in the data file
+    RateStream _stream;
+    bool _has_rate;
+    double _rate;       // rate in effect on _last_date
+    bool _has_next;
+    int _next_date;     // first unconsumed row
+    double _next_rate;
+    int _last_date;     // previous date requested (while _has_rate)
+    bool _indexed;
+    BitcoinExchange _index;
+};
+
+// State shared by the workers of convert_in_parallel and the thread that
+// replays their output.
+struct Pipeline {
+    const BitcoinExchange *btc;
+    std::vector<const char *> bounds;  // chunk i is [bounds[i], bounds[i + 1])
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;             // a report was filled or replayed
+};
+
+// A worker thread, kept for the whole input: it converts chunks first,
+// first + stride, ... into its two reports in turn, so that it goes on with
+// its next chunk while the previous one is being replayed.
+struct Worker {
+    Pipeline *pipeline;
+    std::size_t first;
+    std::size_t stride;
+    BufferedReport reports[2];
+    bool full[2];         // guarded by pipeline->mutex
+    DateRateCache cache;  // dates repeat between chunks
+};
+
+void convert_stream(RateSource &rates, const std::string &file_name);
+void convert_line(RateSource &rates, const std::string &line,
+    DateRateCache &cache, ConversionReport &report);
 bool retrieve_date_and_value(const std::string &line,
-    std::string &date_str, std::string &value_str);
+    std::string &date_str, std::string &value_str,
+    ConversionReport &report);
+void reject_line(const std::string &line, const std::string &reason,
+    ConversionReport &report);
+std::size_t resolve_thread_count(std::size_t num_threads);
+bool use_parallel_path(const std::string &file_name,
+    std::size_t num_threads);
+void convert_in_parallel(const BitcoinExchange &btc,
+    const std::string &file_name, std::size_t num_threads);
+void *run_worker(void *arg);
+void convert_chunk(Worker &worker, std::size_t chunk, ConversionReport &report);
+void wait_for_report(Worker &worker, std::size_t slot, bool full);
+void set_report_full(Worker &worker, std::size_t slot, bool full);
+std::size_t format_result_line(const char *date_text, std::size_t date_size,
+    double value, double result, char *line);
+void append_double(std::string &text, double value);
+void log_cache_counters(std::size_t hits, std::size_t misses);
 }  // namespace
 
+/*
+ * @brief Converts every "date | value" line of file_name and prints the
+ *        results (stdout) and rejected lines (stderr).
+ * @param num_threads Worker threads for large regular files; 0 picks one per
+ *        online CPU, 1 keeps everything on the calling thread.
+ * @note The output (stdout, stderr and the log) is the same, in the same
+ *       order, whatever the number of threads.
+ */
 void convert_and_print(const BitcoinExchange &btc,
-    const std::string &file_name) {
+    const std::string &file_name, std::size_t num_threads) {
     toolbox::logger::StepMark::info(std::string(
         "Starting conversion using input file: ") + file_name);
+    num_threads = resolve_thread_count(num_threads);
+    if (use_parallel_path(file_name, num_threads)) {
+        convert_in_parallel(btc, file_name, num_threads);
+        toolbox::logger::StepMark::info(std::string(
+            "Completed conversion for input file: ") + file_name);
+        return;
+    }
+    IndexedRates rates(btc);
+    convert_stream(rates, file_name);
+    toolbox::logger::StepMark::info(std::string(
+        "Completed conversion for input file: ") + file_name);
+}
+
+/*
+ * @brief Same output as convert_and_print, for a data file and an input
+ *        file that are both sorted by date: the two files are read side by
+ *        side and the rate history is never loaded, so memory does not grow
+ *        with either file.
+ * @note The data file is read twice: once to check its order (and report
+ *       its malformed rows, as load_data would), then along the input. If
+ *       it is not sorted, the conversion goes through load_data and
+ *       convert_and_print instead; if the input goes back in time, the
+ *       history is loaded at that point and the remaining lines are looked
+ *       up in it.
+ */
+void convert_and_print_sorted(const std::string &data_filename,
+    const std::string &file_name) {
+    toolbox::logger::StepMark::info(std::string(
+        "Checking the order of exchange rate data file: ") + data_filename);
+    RateStream check;
+    std::size_t rows = 0;
+    if (check.open(data_filename, true)) {
+        int serial_date;
+        double rate;
+        while (check.next(serial_date, rate)) {
+            ++rows;
+        }
+    }
+    if (!check.sorted()) {
+        toolbox::logger::StepMark::notice(
+            "Exchange rate data is not sorted by date, "
+            "using the indexed conversion");
+        BitcoinExchange btc;
+        btc.load_data(data_filename, check.position());
+        check.close();
+        convert_and_print(btc, file_name);
+        return;
+    }
+    check.close();
+    std::ostringstream oss;
+    oss << "Exchange rate data is sorted by date (" << rows
+        << " entries), streaming it alongside input file: " << file_name;
+    toolbox::logger::StepMark::info(oss.str());
+    StreamedRates rates(data_filename, rows);
+    convert_stream(rates, file_name);
+    toolbox::logger::StepMark::info(std::string(
+        "Completed conversion for input file: ") + file_name);
+}
+
+namespace {
+IndexedRates::IndexedRates(const BitcoinExchange &btc) : _btc(btc) {}
+
+bool IndexedRates::find(int serial_date, double &rate) {
+    return _btc.find_exchange_rate(toolbox::Date(serial_date), rate);
+}
+
+bool IndexedRates::empty() const {
+    return _btc.empty();
+}
+
+StreamedRates::StreamedRates(const std::string &data_filename,
+    std::size_t rows)
+    : _data_filename(data_filename), _rows(rows), _stream(),
+    _has_rate(false), _rate(0.0), _has_next(false), _next_date(0),
+    _next_rate(0.0), _last_date(0), _indexed(false), _index() {
+    if (_stream.open(_data_filename, false)) {
+        _has_next = _stream.next(_next_date, _next_rate);
+    }
+}
+
+/*
+ * @note [complexity]: amortized O(1) per row of the data file while the
+ *       dates requested do not decrease.
+ */
+bool StreamedRates::find(int serial_date, double &rate) {
+    if (!_indexed && _has_rate && serial_date < _last_date) {
+        load_index();
+    }
+    if (_indexed) {
+        return _index.find_exchange_rate(toolbox::Date(serial_date), rate);
+    }
+    while (_has_next && _next_date <= serial_date) {
+        _rate = _next_rate;
+        _has_rate = true;
+        _has_next = _stream.next(_next_date, _next_rate);
+    }
+    if (!_has_rate) {
+        return false;
+    }
+    _last_date = serial_date;
+    rate = _rate;
+    return true;
+}
+
+bool StreamedRates::empty() const {
+    return _rows == 0;
+}
+
+void StreamedRates::load_index() {
+    toolbox::logger::StepMark::notice(
+        "Input dates are not sorted, loading the exchange rate history");
+    _stream.close();
+    _index.load_data(_data_filename, static_cast<std::size_t>(-1));
+    _indexed = true;
+}
+
+// Converts the lines of file_name (after its header) one at a time.
+void convert_stream(RateSource &rates, const std::string &file_name) {
     std::ifstream file(file_name.c_str());
     if (!file.is_open()) {
         toolbox::logger::StepMark::error(std::string(
@@ -34,70 +279,111 @@ void convert_and_print(const BitcoinExchange &btc,
         toolbox::logger::StepMark::warning(std::string(
             "Invalid header in input file: ") + file_name);
     }
+    StreamReport report;
+    DateRateCache cache;
     while (std::getline(file, line)) {
-        std::string date_str, value_str;
-        if (!retrieve_date_and_value(line, date_str, value_str)) {
-            continue;
-        }
-        toolbox::Date date;
-        double value;
-        try {
-            date = toolbox::Date(toolbox::GREGORIAN, date_str, "%Y-%m-%d");
-            value = toolbox::stod(value_str);
-        } catch (const std::exception &e) {
-            std::cerr << "Error: bad input => " << line << std::endl;
-            std::ostringstream oss;
-            oss << "Rejected input line due to parsing error: " << line
-                << " (" << e.what() << ")";
-            toolbox::logger::StepMark::error(oss.str());
-            continue;
-        }
-        if (value < 0.0) {
-            std::cerr << "Error: not a positive number." << std::endl;
-            toolbox::logger::StepMark::error(std::string(
-                "Input value is negative: ") + value_str);
-            continue;
-        }
-        if (value > 1000.0) {
-            std::cerr << "Error: too large a number." << std::endl;
-            toolbox::logger::StepMark::error(std::string(
-                "Input value exceeds limit: ") + value_str);
-            continue;
+        convert_line(rates, line, cache, report);
+    }
+    log_cache_counters(cache.hits(), cache.misses());
+}
+
+/*
+ * @note A date token already in cache skips both the date parsing and the
+ *       rate lookup. Only dates that resolved to a rate are cached, so a
+ *       rejected line always goes through the full path (and reports the
+ *       same reason).
+ */
+void convert_line(RateSource &rates, const std::string &line,
+    DateRateCache &cache, ConversionReport &report) {
+    std::string date_str, value_str;
+    if (!retrieve_date_and_value(line, date_str, value_str, report)) {
+        return;
+    }
+    // Malformed lines are common in some inputs: they are detected through
+    // return values, without an exception per line.
+    int serial_date;
+    double rate;
+    const bool cached = cache.find(date_str.data(), date_str.size(),
+        serial_date, rate);
+    GregorianDate date(cached ? serial_date : 0);
+    if (!cached) {
+        const toolbox::ParseResult parsed = date.parse(date_str, date_format);
+        if (parsed.status != toolbox::ParseResult::OK) {
+            reject_line(line, parsed.message, report);
+            return;
         }
-        try {
-            double rate = btc.get_exchange_rate(date);
-            double result = value * rate;
-            std::cout << date.to_string(toolbox::GREGORIAN, "%Y-%m-%d")
-                << " => " << value << " = " << result << std::endl;
-            std::ostringstream oss;
-            oss << "Converted " << value << " on "
-                << date.to_string(toolbox::GREGORIAN, "%Y-%m-%d")
-                << " using rate " << rate << " (result: " << result << ")";
-            toolbox::logger::StepMark::info(oss.str());
-        } catch (const std::exception &e) {
-            std::cerr << "Error: no exchange rate available for date: "
-                << date.to_string(toolbox::GREGORIAN, "%Y-%m-%d");
-            if (btc.empty()) {
-                std::cerr << " (exchange rate data is empty)";
+    }
+    double value;
+    if (!toolbox::parse_double(value_str.data(), value_str.size(), value)) {
+        reject_line(line, "Invalid double: '" + value_str + "'", report);
+        return;
+    }
+    if (value < 0.0) {
+        report.write(ConversionReport::STDERR,
+            "Error: not a positive number.");
+        report.write(ConversionReport::LOG_ERROR, std::string(
+            "Input value is negative: ") + value_str);
+        return;
+    }
+    if (value > 1000.0) {
+        report.write(ConversionReport::STDERR,
+            "Error: too large a number.");
+        report.write(ConversionReport::LOG_ERROR, std::string(
+            "Input value exceeds limit: ") + value_str);
+        return;
+    }
+    char date_text[toolbox::DATE_BUFFER_SIZE];
+    const std::size_t date_size
+        = date.to_string(date_text, sizeof(date_text), date_format);
+    if (!cached) {
+        if (!rates.find(date.get_raw_date(), rate)) {
+            std::string err("Error: no exchange rate available for date: ");
+            err.append(date_text, date_size);
+            if (rates.empty()) {
+                err += " (exchange rate data is empty)";
             }
-            std::cerr << std::endl;
-            toolbox::logger::StepMark::error(std::string(
-                "Exchange rate lookup failed for date: ")
-                + date.to_string(toolbox::GREGORIAN, "%Y-%m-%d")
-                + std::string(" (reason: ") + e.what() + ")");
+            report.write(ConversionReport::STDERR, err);
+            report.write(ConversionReport::LOG_ERROR, std::string(
+                "Exchange rate lookup failed for date: ") + date_text
+                + " (reason: No exchange rate data available for the given"
+                " date or earlier)");
+            return;
         }
+        cache.insert(date_str.data(), date_str.size(), date.get_raw_date(),
+            rate);
     }
-    toolbox::logger::StepMark::info(std::string(
-        "Completed conversion for input file: ") + file_name);
+    double result = value * rate;
+    char line_buf[128];
+    report.write(ConversionReport::STDOUT, line_buf, format_result_line(
+        date_text, date_size, value, result, line_buf));
+    std::string message("Converted ");
+    append_double(message, value);
+    message += " on ";
+    message.append(date_text, date_size);
+    message += " using rate ";
+    append_double(message, rate);
+    message += " (result: ";
+    append_double(message, result);
+    message += ")";
+    report.write(ConversionReport::LOG_INFO, message);
+}
+
+// Reports a line whose date or value does not parse.
+void reject_line(const std::string &line, const std::string &reason,
+    ConversionReport &report) {
+    report.write(ConversionReport::STDERR, "Error: bad input => " + line);
+    report.write(ConversionReport::LOG_ERROR,
+        "Rejected input line due to parsing error: " + line
+        + " (" + reason + ")");
 }
 
-namespace {
 bool retrieve_date_and_value(const std::string &line,
-    std::string &date_str, std::string &value_str) {
+    std::string &date_str, std::string &value_str,
+    ConversionReport &report) {
     std::size_t pos_delimiter = line.find("|");
     if (pos_delimiter == std::string::npos) {
-        std::cerr << "Error: bad input => " << line << std::endl;
-        toolbox::logger::StepMark::error(std::string(
+        report.write(ConversionReport::STDERR, "Error: bad input => " + line);
+        report.write(ConversionReport::LOG_ERROR, std::string(
             "Missing delimiter in input line: ") + line);
         return false;
     }
@@ -119,4 +405,210 @@ bool retrieve_date_and_value(const std::string &line,
     value_str = line.substr(value_str_start, value_str_end - value_str_start);
     return true;
 }
+
+std::size_t resolve_thread_count(std::size_t num_threads) {
+    if (num_threads != 0) {
+        return num_threads;
+    }
+    const long online = ::sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? static_cast<std::size_t>(online) : 1;
+}
+
+// Only large regular files are worth splitting; anything else (pipes,
+// small files) keeps streaming through std::getline.
+bool use_parallel_path(const std::string &file_name,
+    std::size_t num_threads) {
+    if (num_threads < 2) {
+        return false;
+    }
+    struct stat st;
+    return ::stat(file_name.c_str(), &st) == 0 && S_ISREG(st.st_mode)
+        && static_cast<std::size_t>(st.st_size) >= parallel_min_bytes;
+}
+
+/*
+ * @brief Parallel body of convert_and_print.
+ * @note The input is cut into chunks at newline boundaries, which are dealt
+ *       round-robin to num_threads workers started once for the whole
+ *       input. Each worker converts its chunks into BufferedReports; the
+ *       calling thread replays them in input order, and is the only one
+ *       touching the streams and the (non thread-safe) logger.
+ */
+void convert_in_parallel(const BitcoinExchange &btc,
+    const std::string &file_name, std::size_t num_threads) {
+    toolbox::MappedFile file;
+    if (!file.open(file_name)) {
+        toolbox::logger::StepMark::error(std::string(
+            "Failed to open input file: ") + file_name);
+        throw std::runtime_error("Failed to open input file: " + file_name);
+    }
+    const char *cursor = file.data();
+    const char *const end = cursor + file.size();
+    if (cursor == end) {
+        toolbox::logger::StepMark::error(std::string(
+            "Input file is empty: ") + file_name);
+        throw std::runtime_error("Input file is empty: " + file_name);
+    }
+    const char *header_end = static_cast<const char *>(
+        std::memchr(cursor, '\n', end - cursor));
+    if (header_end == NULL) {
+        header_end = end;
+    }
+    const char header[] = "date | value";
+    if (static_cast<std::size_t>(header_end - cursor) != sizeof(header) - 1
+        || std::memcmp(cursor, header, sizeof(header) - 1) != 0) {
+        std::cerr << "Warning: invalid header in input file: " << file_name
+            << " (Expecting 'date | value')" << std::endl;
+        toolbox::logger::StepMark::warning(std::string(
+            "Invalid header in input file: ") + file_name);
+    }
+    cursor = (header_end == end) ? end : header_end + 1;
+
+    Pipeline pipeline;
+    pipeline.btc = &btc;
+    pipeline.bounds.push_back(cursor);
+    while (cursor != end) {
+        const char *chunk_end = end;
+        if (static_cast<std::size_t>(end - cursor) > chunk_bytes) {
+            chunk_end = static_cast<const char *>(std::memchr(
+                cursor + chunk_bytes, '\n', end - (cursor + chunk_bytes)));
+            chunk_end = (chunk_end == NULL) ? end : chunk_end + 1;
+        }
+        pipeline.bounds.push_back(chunk_end);
+        cursor = chunk_end;
+    }
+    const std::size_t chunk_count = pipeline.bounds.size() - 1;
+    num_threads = std::min(num_threads, std::max<std::size_t>(chunk_count, 1));
+    std::ostringstream oss;
+    oss << "Converting in parallel with " << num_threads << " threads";
+    toolbox::logger::StepMark::info(oss.str());
+
+    ::pthread_mutex_init(&pipeline.mutex, NULL);
+    ::pthread_cond_init(&pipeline.changed, NULL);
+    std::vector<Worker> workers(num_threads);
+    std::vector<pthread_t> threads(num_threads);
+    std::vector<bool> started(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        workers[i].pipeline = &pipeline;
+        workers[i].first = i;
+        workers[i].stride = num_threads;
+        workers[i].full[0] = false;
+        workers[i].full[1] = false;
+        started[i] = (::pthread_create(&threads[i], NULL, run_worker,
+            &workers[i]) == 0);
+    }
+    // Chunk c is the (c / num_threads)-th of its worker, hence goes to
+    // report (c / num_threads) % 2. A worker that did not start has its
+    // chunks converted here, when their turn comes.
+    StreamReport output;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        const std::size_t w = chunk % num_threads;
+        const std::size_t slot = (chunk / num_threads) % 2;
+        BufferedReport &report = workers[w].reports[slot];
+        if (started[w]) {
+            wait_for_report(workers[w], slot, true);
+        } else {
+            convert_chunk(workers[w], chunk, report);
+        }
+        report.replay(output);
+        report.clear();
+        if (started[w]) {
+            set_report_full(workers[w], slot, false);
+        }
+    }
+    std::size_t hits = 0, misses = 0;
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        if (started[i]) {
+            ::pthread_join(threads[i], NULL);
+        }
+        hits += workers[i].cache.hits();
+        misses += workers[i].cache.misses();
+    }
+    ::pthread_cond_destroy(&pipeline.changed);
+    ::pthread_mutex_destroy(&pipeline.mutex);
+    log_cache_counters(hits, misses);
+}
+
+// Thread entry point: converts the chunks of a Worker, each into whichever
+// of its reports has been replayed.
+void *run_worker(void *arg) {
+    Worker &worker = *static_cast<Worker *>(arg);
+    const std::size_t chunk_count = worker.pipeline->bounds.size() - 1;
+    std::size_t round = 0;
+    for (std::size_t chunk = worker.first; chunk < chunk_count;
+        chunk += worker.stride, ++round) {
+        const std::size_t slot = round % 2;
+        wait_for_report(worker, slot, false);
+        convert_chunk(worker, chunk, worker.reports[slot]);
+        set_report_full(worker, slot, true);
+    }
+    return NULL;
+}
+
+// Converts every line of one chunk of the input into report.
+void convert_chunk(Worker &worker, std::size_t chunk,
+    ConversionReport &report) {
+    IndexedRates rates(*worker.pipeline->btc);
+    const char *cursor = worker.pipeline->bounds[chunk];
+    const char *const end = worker.pipeline->bounds[chunk + 1];
+    std::string line;
+    while (cursor != end) {
+        const char *newline = static_cast<const char *>(
+            std::memchr(cursor, '\n', end - cursor));
+        const char *line_end = (newline == NULL) ? end : newline;
+        line.assign(cursor, line_end);
+        convert_line(rates, line, worker.cache, report);
+        cursor = (newline == NULL) ? end : newline + 1;
+    }
+}
+
+// Blocks until report slot of worker is full (or, with !full, replayed).
+void wait_for_report(Worker &worker, std::size_t slot, bool full) {
+    Pipeline &pipeline = *worker.pipeline;
+    ::pthread_mutex_lock(&pipeline.mutex);
+    while (worker.full[slot] != full) {
+        ::pthread_cond_wait(&pipeline.changed, &pipeline.mutex);
+    }
+    ::pthread_mutex_unlock(&pipeline.mutex);
+}
+
+void set_report_full(Worker &worker, std::size_t slot, bool full) {
+    Pipeline &pipeline = *worker.pipeline;
+    ::pthread_mutex_lock(&pipeline.mutex);
+    worker.full[slot] = full;
+    ::pthread_cond_broadcast(&pipeline.changed);
+    ::pthread_mutex_unlock(&pipeline.mutex);
+}
+
+/*
+ * @brief Writes "<date> => <value> = <result>" into line (at least 128
+ *        bytes), with the numbers as std::ostream prints them by default.
+ * @return The length of the line.
+ */
+std::size_t format_result_line(const char *date_text, std::size_t date_size,
+    double value, double result, char *line) {
+    date_size = std::min<std::size_t>(date_size, toolbox::DATE_BUFFER_SIZE);
+    std::memcpy(line, date_text, date_size);
+    std::size_t size = date_size;
+    std::memcpy(line + size, " => ", 4);
+    size += 4;
+    size += toolbox::format_double(value, line + size, stream_precision);
+    std::memcpy(line + size, " = ", 3);
+    size += 3;
+    size += toolbox::format_double(result, line + size, stream_precision);
+    return size;
+}
+
+void append_double(std::string &text, double value) {
+    char buffer[toolbox::DOUBLE_BUFFER_SIZE];
+    text.append(buffer, toolbox::format_double(value, buffer,
+        stream_precision));
+}
+
+// Logs how often the date cache spared a parse and a lookup, for sizing it.
+void log_cache_counters(std::size_t hits, std::size_t misses) {
+    std::ostringstream oss;
+    oss << "Date cache: " << hits << " hits, " << misses << " misses";
+    toolbox::logger::StepMark::info(oss.str());
+}
 }  // namespace
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 #include <ex00/BitcoinExchange.hpp>
 #include <toolbox/string.hpp>
 
 void convert_and_print(const BitcoinExchange &btc,
+    const std::string &file_name, std::size_t num_threads = 0);
+void convert_and_print_sorted(const std::string &data_filename,
     const std::string &file_name);
@@ -22,7 +22,9 @@ int main(int argc, char **argv) {
     try {
         toolbox::logger::StepMark::info(
             "Initializing BitcoinExchange with data.csv");
-        BitcoinExchange btc_exchange("data.csv");
+        BitcoinExchange btc_exchange;
+        btc_exchange.set_lookup_mode(BitcoinExchange::DENSE_TABLE);
+        btc_exchange.load_data("data.csv");
         toolbox::logger::StepMark::info(std::string(
             "Processing input file: ") + argv[1]);
         convert_and_print(btc_exchange, argv[1]);
@@ -0,0 +1,57 @@
+#include <ex00/utils/test.hpp>
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <toolbox/StepMark.hpp>
+
+namespace {
+std::size_t checks = 0;
+std::size_t failures = 0;
+}  // namespace
+
+void test() {
+    toolbox::logger::StepMark::info("test: start");
+    test_dates();
+    test_numbers();
+    test_shared();
+    test_exchange();
+    test_rates();
+    test_conversion();
+    std::cout << (checks - failures) << "/" << checks << " checks passed"
+        << std::endl;
+    toolbox::logger::StepMark::info("test: completed");
+}
+
+// Counts a check; a failed one is reported on std::cout and in the log.
+bool check(bool condition, const std::string &what) {
+    ++checks;
+    if (!condition) {
+        ++failures;
+        std::cout << "FAILED: " << what << std::endl;
+        toolbox::logger::StepMark::error("test: failed: " + what);
+    }
+    return condition;
+}
+
+std::size_t test_failures() {
+    return failures;
+}
+
+// Writes content to filename, replacing it. Tests remove what they write.
+void write_test_file(const std::string &filename, const std::string &content) {
+    std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+    file << content;
+}
+
+// xorshift32: reproducible pseudo-random numbers, from a nonzero state.
+uint32_t next_random(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
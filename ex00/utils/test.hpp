@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string>
+
+// Self-checks of ex00, built as btc_test by "make test". Each test_*
+// function covers one area and reports every failed check through check();
+// test() runs them all.
+void test();
+bool check(bool condition, const std::string &what);
+std::size_t test_failures();
+void write_test_file(const std::string &filename, const std::string &content);
+uint32_t next_random(uint32_t &state);
+
+void test_dates();
+void test_numbers();
+void test_shared();
+void test_exchange();
+void test_rates();
+void test_conversion();
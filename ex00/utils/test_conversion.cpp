@@ -0,0 +1,257 @@
+#include <ex00/utils/test.hpp>
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ex00/BitcoinExchange.hpp>
+#include <ex00/DateRateCache.hpp>
+#include <ex00/conversion.hpp>
+
+namespace {
+// What a conversion printed.
+struct Printed {
+    std::string out;
+    std::string err;
+};
+
+// Sends std::cout and std::cerr to strings for its lifetime.
+class CapturedOutput {
+ public:
+    CapturedOutput();
+    ~CapturedOutput();
+
+    Printed printed() const;
+
+ private:
+    CapturedOutput(const CapturedOutput &other);
+    CapturedOutput &operator=(const CapturedOutput &other);
+
+    std::ostringstream _out;
+    std::ostringstream _err;
+    std::streambuf *_cout_buffer;
+    std::streambuf *_cerr_buffer;
+};
+
+void test_parallel_conversion();
+void test_sorted_conversion();
+void test_date_cache();
+Printed convert(const BitcoinExchange &btc, const std::string &file_name,
+    std::size_t num_threads);
+Printed load_and_convert(const std::string &data_filename,
+    const std::string &file_name);
+Printed convert_sorted(const std::string &data_filename,
+    const std::string &file_name);
+std::string input_lines(std::size_t min_bytes, uint32_t seed);
+}  // namespace
+
+void test_conversion() {
+    test_parallel_conversion();
+    test_sorted_conversion();
+    test_date_cache();
+}
+
+namespace {
+// The parallel path prints what the sequential one prints. The input is
+// five chunks: two workers go through both of their reports and back, and
+// eight workers are more than there are chunks.
+void test_parallel_conversion() {
+    write_test_file("btc_test_rates.csv", "date,exchange_rate\n"
+        "2009-01-02,0\n2012-03-04,4.5\n2015-06-07,250.25\n2020-01-01,7200\n");
+    write_test_file("btc_test_input.txt", "date | value\n"
+        + input_lines(17 * 1024 * 1024, 99));
+    const BitcoinExchange btc("btc_test_rates.csv");
+    const Printed sequential = convert(btc, "btc_test_input.txt", 1);
+    check(!sequential.out.empty() && !sequential.err.empty(),
+        "convert_and_print: converts and rejects lines");
+    const std::size_t threads[] = {2, 8};
+    for (std::size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+        const Printed parallel = convert(btc, "btc_test_input.txt",
+            threads[i]);
+        std::ostringstream what;
+        what << "convert_and_print: " << threads[i]
+            << " threads print what 1 thread prints";
+        check(parallel.out == sequential.out
+            && parallel.err == sequential.err, what.str());
+    }
+    std::remove("btc_test_rates.csv");
+    std::remove("btc_test_input.txt");
+}
+
+/*
+ * @brief convert_and_print_sorted prints what load_data and
+ *        convert_and_print print, on sorted files and on the ones it has to
+ *        fall back from: a data row out of order, and an input line going
+ *        back in time.
+ */
+void test_sorted_conversion() {
+    const std::string rows = "2011-01-27,237.96\n2011-01-28,544.23\n"
+        "2011-01-29,369.96\n2011-01-29,1.50\n2011-01-31,abc\n"
+        "2011-02-01,65.53\ngarbage\n2011-02-03,-13.17\n2011-02-04,837.47\n";
+    write_test_file("btc_test_sorted.csv", "date,exchange_rate\n" + rows);
+    write_test_file("btc_test_unsorted.csv", "date,exchange_rate\n" + rows
+        + "2011-01-30,603.92\n2011-02-05,1.25\n");
+    write_test_file("btc_test_empty.csv", "");
+    const std::string lines = "date | value\n2011-01-17 | 6.91\n"
+        "2011-01-27 | 3.22\n2011-01-29 | 8.35\n2011-01-29 | 1\n"
+        "2011-01-30 | 7.21\nbad line\n2011-02-03 | 2.59\n"
+        "2011-02-06 | 2000\n2011-02-07 | -1\n2011-02-31 | 1\n";
+    write_test_file("btc_test_sorted.txt", lines + "2012-01-01 | 3\n");
+    write_test_file("btc_test_unsorted.txt", lines
+        + "2011-01-28 | 4\n2011-02-04 | 5\n2011-01-27 | 6\n");
+
+    const char *data[] = {"btc_test_sorted.csv", "btc_test_unsorted.csv",
+        "btc_test_empty.csv", "btc_test_missing.csv"};
+    const char *inputs[] = {"btc_test_sorted.txt", "btc_test_unsorted.txt"};
+    for (std::size_t d = 0; d < sizeof(data) / sizeof(data[0]); ++d) {
+        for (std::size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i) {
+            const Printed indexed = load_and_convert(data[d], inputs[i]);
+            const Printed sorted = convert_sorted(data[d], inputs[i]);
+            check(sorted.out == indexed.out && sorted.err == indexed.err,
+                std::string("convert_and_print_sorted: ") + data[d] + ", "
+                + inputs[i]);
+        }
+    }
+    const Printed duplicates = convert_sorted("btc_test_sorted.csv",
+        "btc_test_sorted.txt");
+    check(duplicates.err.find("duplicate date entry in data file: "
+        "2011-01-29,1.50") != std::string::npos
+        && duplicates.out.find("2011-01-29 => 8.35 = 12.525")
+            != std::string::npos,
+        "convert_and_print_sorted: a duplicate date keeps its last rate");
+    std::remove("btc_test_sorted.csv");
+    std::remove("btc_test_unsorted.csv");
+    std::remove("btc_test_empty.csv");
+    std::remove("btc_test_sorted.txt");
+    std::remove("btc_test_unsorted.txt");
+}
+
+// Far more dates than the cache holds, looked up in random order and
+// inserted on a miss: past the load limit entries get replaced, but a hit
+// is always the serial date and rate inserted for that very key, the size
+// stays within the limit, and every lookup is a hit or a miss.
+void test_date_cache() {
+    DateRateCache cache(64);
+    std::vector<std::string> keys;
+    char key[16];
+    for (int i = 0; i < 500; ++i) {
+        std::sprintf(key, "%04d-%02d-%02d", 2010 + i / 336, 1 + i / 28 % 12,
+            1 + i % 28);
+        keys.push_back(key);
+    }
+    uint32_t state = 4242;
+    std::size_t wrong = 0;
+    std::size_t lookups = 0;
+    std::size_t max_size = 0;
+    for (int i = 0; i < 20000; ++i) {
+        // Mostly a few recent dates, as in an input file, and now and then
+        // any of them.
+        const std::size_t k = (i % 4 == 0) ? next_random(state) % keys.size()
+            : (static_cast<std::size_t>(i) / 40 + next_random(state) % 8)
+                % keys.size();
+        int serial = -1;
+        double rate = -1.0;
+        ++lookups;
+        if (cache.find(keys[k].data(), keys[k].size(), serial, rate)) {
+            wrong += serial != static_cast<int>(k) || rate != k * 0.5;
+        } else {
+            cache.insert(keys[k].data(), keys[k].size(),
+                static_cast<int>(k), k * 0.5);
+        }
+        if (cache.size() > max_size) {
+            max_size = cache.size();
+        }
+    }
+    check(wrong == 0, "DateRateCache: hits are the entry of their key");
+    check(max_size == cache.capacity() / 4 * 3,
+        "DateRateCache: size reaches the load limit and stays there");
+    check(cache.hits() + cache.misses() == lookups && cache.hits() != 0
+        && cache.misses() != 0, "DateRateCache: hits and misses counted");
+
+    int serial = 0;
+    double rate = 0.0;
+    cache.insert("2011-01-3", 9, 1, 1.0);
+    check(!cache.find("2011-01-3", 9, serial, rate)
+        && cache.misses() + cache.hits() == lookups + 1,
+        "DateRateCache: tokens of another size are not cached");
+    cache.clear();
+    check(cache.size() == 0 && cache.hits() == 0 && cache.misses() == 0
+        && !cache.find(keys[0].data(), keys[0].size(), serial, rate),
+        "DateRateCache: clear");
+}
+
+CapturedOutput::CapturedOutput()
+    : _out(), _err(), _cout_buffer(std::cout.rdbuf(_out.rdbuf())),
+    _cerr_buffer(std::cerr.rdbuf(_err.rdbuf())) {}
+
+CapturedOutput::~CapturedOutput() {
+    std::cout.rdbuf(_cout_buffer);
+    std::cerr.rdbuf(_cerr_buffer);
+}
+
+Printed CapturedOutput::printed() const {
+    Printed printed;
+    printed.out = _out.str();
+    printed.err = _err.str();
+    return printed;
+}
+
+Printed convert(const BitcoinExchange &btc, const std::string &file_name,
+        std::size_t num_threads) {
+    CapturedOutput output;
+    convert_and_print(btc, file_name, num_threads);
+    return output.printed();
+}
+
+// What main prints: load_data, then convert_and_print.
+Printed load_and_convert(const std::string &data_filename,
+        const std::string &file_name) {
+    CapturedOutput output;
+    BitcoinExchange btc;
+    btc.load_data(data_filename);
+    convert_and_print(btc, file_name, 1);
+    return output.printed();
+}
+
+Printed convert_sorted(const std::string &data_filename,
+        const std::string &file_name) {
+    CapturedOutput output;
+    convert_and_print_sorted(data_filename, file_name);
+    return output.printed();
+}
+
+// At least min_bytes of "date | value" lines, mostly valid, with dates
+// before the history, bad dates, negative and too large values, and lines
+// without a delimiter.
+std::string input_lines(std::size_t min_bytes, uint32_t seed) {
+    std::string text;
+    char line[64];
+    while (text.size() < min_bytes) {
+        next_random(seed);
+        const int year = 2008 + static_cast<int>(seed % 15);
+        const int month = 1 + static_cast<int>((seed >> 4) % 12);
+        const int day = 1 + static_cast<int>((seed >> 8) % 28);
+        const unsigned kind = (seed >> 16) % 50;
+        if (kind == 0) {
+            std::sprintf(line, "%04d-13-%02d | 1\n", year, day);
+        } else if (kind == 1) {
+            std::sprintf(line, "%04d-%02d-%02d | -%u\n", year, month, day,
+                seed % 9 + 1);
+        } else if (kind == 2) {
+            std::sprintf(line, "%04d-%02d-%02d | 1001\n", year, month, day);
+        } else if (kind == 3) {
+            std::sprintf(line, "%04d-%02d-%02d\n", year, month, day);
+        } else {
+            std::sprintf(line, "%04d-%02d-%02d | %u.%02u\n", year, month, day,
+                (seed >> 20) % 1000, seed % 100);
+        }
+        text += line;
+    }
+    return text;
+}
+}  // namespace
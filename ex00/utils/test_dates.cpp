@@ -0,0 +1,498 @@
+#include <ex00/utils/test.hpp>
+
+#include <stdint.h>
+
+#include <climits>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <ex00/Date.hpp>
+#include <ex00/Timestamp.hpp>
+#include <ex00/calendar_system/CalendarSystem.hpp>
+#include <ex00/calendar_system/DateFormat.hpp>
+#include <ex00/calendar_system/EthiopianCalendar.hpp>
+#include <ex00/calendar_system/FrenchRepublicanCalendar.hpp>
+#include <ex00/calendar_system/GregorianCalendar.hpp>
+#include <ex00/calendar_system/ICalendarSystem.hpp>
+#include <ex00/calendar_system/JulianCalendar.hpp>
+#include <ex00/calendar_system/NonProlepticGregorianCalendar.hpp>
+
+namespace {
+void test_iso_fast_path();
+void test_civil_date();
+void test_julian_table();
+void test_ethiopian_table();
+void test_other_tables();
+void test_batch_conversions();
+void test_timestamp_text();
+void test_timestamp_fields();
+bool parses_timestamp(const char *text, int64_t expected);
+bool rejects_timestamp(const char *text);
+std::size_t walk_dates(const toolbox::ICalendarSystem &calendar, int era,
+    int first_year, int last_year, int &serial);
+std::size_t round_trips(const toolbox::ICalendarSystem &calendar,
+    int first_serial, int last_serial, uint32_t seed);
+std::string scalar_error(const toolbox::ICalendarSystem &calendar, int era,
+    int year, int month, int day);
+std::string batch_error(const toolbox::ICalendarSystem &calendar,
+    const std::vector<int> &eras, const std::vector<int> &years,
+    const std::vector<int> &months, const std::vector<int> &days);
+}  // namespace
+
+void test_dates() {
+    test_iso_fast_path();
+    test_civil_date();
+    test_julian_table();
+    test_ethiopian_table();
+    test_other_tables();
+    test_batch_conversions();
+    test_timestamp_text();
+    test_timestamp_fields();
+}
+
+namespace {
+// A fixed-width "YYYY-MM-DD" string is decided by the fast path, with the
+// result of the generic parser; anything else is left to the latter.
+void test_iso_fast_path() {
+    struct Case {
+        const char *text;
+        int year;
+        int month;
+        int day;
+    };
+    const Case valid[] = {
+        {"2019-08-29", 2019, 8, 29}, {"2018-09-30", 2018, 9, 30},
+        {"2009-01-02", 2009, 1, 2}, {"2000-02-29", 2000, 2, 29},
+        {"1999-12-31", 1999, 12, 31}, {"1000-01-01", 1000, 1, 1},
+        {"9999-12-31", 9999, 12, 31}
+    };
+    const toolbox::GregorianCalendar calendar;
+    for (std::size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); ++i) {
+        toolbox::ParseResult result;
+        int serial = 0;
+        const std::string what = std::string("fast path: ") + valid[i].text;
+        check(toolbox::GregorianCalendar::parse_iso_date(valid[i].text,
+            result, serial), what + " taken");
+        check(result.status == toolbox::ParseResult::OK, what + " valid");
+        check(serial == calendar.to_serial_date(toolbox::GregorianCalendar::AD,
+            valid[i].year, valid[i].month, valid[i].day), what + " serial");
+    }
+
+    const char *invalid[] = {"2019-02-29", "2019-13-01", "2019-00-10",
+        "2019-04-31", "2019-01-00"};
+    for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        toolbox::ParseResult result;
+        int serial = 42;
+        const std::string what = std::string("fast path: ") + invalid[i];
+        check(toolbox::GregorianCalendar::parse_iso_date(invalid[i], result,
+            serial), what + " taken");
+        check(result.status == toolbox::ParseResult::NO_MATCH,
+            what + " rejected");
+        check(serial == 42, what + " leaves serial unchanged");
+    }
+
+    const char *other[] = {"2019-0a-29", "2019-08-2:", "20/9-08-29",
+        "2019/08/29", "2019-8-29", "0999-01-01", "12019-08-29", ""};
+    for (std::size_t i = 0; i < sizeof(other) / sizeof(other[0]); ++i) {
+        toolbox::ParseResult result;
+        int serial = 0;
+        check(!toolbox::GregorianCalendar::parse_iso_date(other[i], result,
+            serial), std::string("fast path: \"") + other[i] + "\" left to "
+            "the generic parser");
+    }
+
+    // A field of a data row is parsed in place, up to its size only.
+    const char row[] = "2019-08-29,10279.47";
+    toolbox::ParseResult result;
+    int serial = 0;
+    check(toolbox::GregorianCalendar::parse_iso_date(row, 10, result, serial)
+        && result.status == toolbox::ParseResult::OK
+        && serial == calendar.to_serial_date(toolbox::GregorianCalendar::AD,
+            2019, 8, 29), "fast path: date field of a row");
+    check(!toolbox::GregorianCalendar::parse_iso_date(row, 11, result,
+        serial), "fast path: field size respected");
+}
+
+// A Date is a bare serial date (cheap to copy, safe to share read-only
+// between threads), and get_civil_date agrees with the single getters.
+void test_civil_date() {
+    check(sizeof(toolbox::Date) == sizeof(int), "Date: only a serial date");
+    const toolbox::CalendarSystem calendars[] = {toolbox::GREGORIAN,
+        toolbox::JULIAN, toolbox::ETHIOPIAN};
+    std::size_t mismatches = 0;
+    for (std::size_t c = 0; c < sizeof(calendars) / sizeof(calendars[0]);
+        ++c) {
+        for (int serial = -800; serial <= 20000; serial += 7) {
+            const toolbox::Date date(serial);
+            const toolbox::CivilDate civil = date.get_civil_date(calendars[c]);
+            if (civil.year != date.get_year(calendars[c])
+                || civil.month != date.get_month(calendars[c])
+                || civil.day != date.get_day(calendars[c])
+                || civil.weekday != date.get_weekday(calendars[c])
+                || toolbox::Date(calendars[c], civil.era, civil.year,
+                    civil.month, civil.day) != date) {
+                ++mismatches;
+            }
+        }
+    }
+    check(mismatches == 0, "Date: get_civil_date matches the getters");
+    const toolbox::CivilDate epoch
+        = toolbox::Date(0).get_civil_date(toolbox::GREGORIAN);
+    check(epoch.year == 1970 && epoch.month == 1 && epoch.day == 1
+        && epoch.weekday == 4, "Date: 1970-01-01 is a Thursday");
+}
+
+// Years 45 BC..AD 3000 go through the year table. Around both of its ends,
+// and across the years before AD 5 that from_serial_date used to get wrong,
+// dates follow each other day by day and convert back to themselves.
+void test_julian_table() {
+    const toolbox::JulianCalendar julian;
+    const toolbox::GregorianCalendar gregorian;
+    int serial = INT_MIN;
+    std::size_t mismatches = walk_dates(julian, toolbox::JulianCalendar::BC,
+        46, 1, serial);
+    mismatches += walk_dates(julian, toolbox::JulianCalendar::AD, 1, 6,
+        serial);
+    serial = INT_MIN;
+    mismatches += walk_dates(julian, toolbox::JulianCalendar::AD, 2999, 3001,
+        serial);
+    check(mismatches == 0, "JulianCalendar: dates around the table ends");
+    // The historical leap years: every third year from 44 BC, then none
+    // until AD 8.
+    check(!julian.is_valid_date(toolbox::JulianCalendar::BC, 45, 2, 29)
+        && julian.is_valid_date(toolbox::JulianCalendar::BC, 44, 2, 29)
+        && !julian.is_valid_date(toolbox::JulianCalendar::AD, 4, 2, 29)
+        && julian.is_valid_date(toolbox::JulianCalendar::AD, 8, 2, 29),
+        "JulianCalendar: leap years around the reform of 45 BC");
+    check(julian.to_serial_date(toolbox::JulianCalendar::AD, 1582, 10, 5)
+        == gregorian.to_serial_date(toolbox::GregorianCalendar::AD,
+            1582, 10, 15), "JulianCalendar: 1582-10-05 is Gregorian 10-15");
+    check(round_trips(julian,
+        julian.to_serial_date(toolbox::JulianCalendar::BC, 45, 1, 1),
+        julian.to_serial_date(toolbox::JulianCalendar::AD, 3000, 12, 31),
+        11) == 0, "JulianCalendar: round trips over the table");
+}
+
+// Years 1..3000 go through the year table. Year starts follow the leap
+// years (year % 4 == 3), so 3-13-6 is the day before 4-1-1.
+void test_ethiopian_table() {
+    const toolbox::EthiopianCalendar ethiopian;
+    const int ad = toolbox::EthiopianCalendar::AD;
+    int serial = INT_MIN;
+    std::size_t mismatches = walk_dates(ethiopian, ad, 1, 5, serial);
+    serial = INT_MIN;
+    mismatches += walk_dates(ethiopian, ad, 2999, 3001, serial);
+    check(mismatches == 0, "EthiopianCalendar: dates around the table ends");
+    check(ethiopian.is_valid_date(ad, 3, 13, 6)
+        && !ethiopian.is_valid_date(ad, 4, 13, 6)
+        && ethiopian.to_serial_date(ad, 3, 13, 6) + 1
+            == ethiopian.to_serial_date(ad, 4, 1, 1),
+        "EthiopianCalendar: 3-13-6 is the day before 4-1-1");
+    const int epoch = ethiopian.to_serial_date(ad, 1, 1, 1);
+    bool thrown = false;
+    try {
+        int era, year, month, day;
+        ethiopian.from_serial_date(epoch - 1, era, year, month, day);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    check(thrown, "EthiopianCalendar: no date before the epoch");
+    check(round_trips(ethiopian, epoch,
+        ethiopian.to_serial_date(ad, 3000, 13, 5), 12) == 0,
+        "EthiopianCalendar: round trips over the table");
+}
+
+// The non-proleptic Gregorian table starts in 1582, where the days before
+// the reform do not exist; the French Republican one is the whole calendar.
+void test_other_tables() {
+    const toolbox::NonProlepticGregorianCalendar reformed;
+    const toolbox::GregorianCalendar gregorian;
+    const int ad = toolbox::NonProlepticGregorianCalendar::AD;
+    check(!reformed.is_valid_date(ad, 1582, 10, 4)
+        && !reformed.is_valid_date(ad, 1582, 10, 14)
+        && reformed.is_valid_date(ad, 1582, 10, 15)
+        && reformed.to_serial_date(ad, 1582, 10, 15)
+            == gregorian.to_serial_date(toolbox::GregorianCalendar::AD,
+                1582, 10, 15), "NonProlepticGregorianCalendar: 1582 reform");
+    int serial = INT_MIN;
+    std::size_t mismatches = walk_dates(reformed, ad, 1581, 1584, serial);
+    serial = INT_MIN;
+    mismatches += walk_dates(reformed, ad, 2999, 3001, serial);
+    check(mismatches == 0,
+        "NonProlepticGregorianCalendar: dates around the table ends");
+    check(round_trips(reformed, reformed.to_serial_date(ad, 1582, 10, 15),
+        reformed.to_serial_date(ad, 3000, 12, 31), 13) == 0,
+        "NonProlepticGregorianCalendar: round trips over the table");
+
+    const toolbox::FrenchRepublicanCalendar french;
+    const int era = toolbox::FrenchRepublicanCalendar::AD;
+    serial = INT_MIN;
+    check(walk_dates(french, era, 1, 15, serial) == 0,
+        "FrenchRepublicanCalendar: every date");
+}
+
+// to_serial_dates and from_serial_dates give, element by element, what the
+// single conversions give, in and out of the year tables; an invalid
+// element makes to_serial_dates throw what to_serial_date throws for it.
+void test_batch_conversions() {
+    const toolbox::GregorianCalendar gregorian;
+    const toolbox::NonProlepticGregorianCalendar reformed;
+    const toolbox::JulianCalendar julian;
+    const toolbox::EthiopianCalendar ethiopian;
+    const toolbox::FrenchRepublicanCalendar french;
+    struct Case {
+        const toolbox::ICalendarSystem *calendar;
+        const char *name;
+        int first_serial;  // of the range dates are drawn from
+        int span;
+    };
+    const Case cases[] = {
+        {&gregorian, "GregorianCalendar", -800000, 1600000},
+        {&reformed, "NonProlepticGregorianCalendar",
+            reformed.to_serial_date(toolbox::NonProlepticGregorianCalendar::AD,
+                1582, 10, 15), 800000},
+        {&julian, "JulianCalendar", -800000, 1600000},
+        {&ethiopian, "EthiopianCalendar",
+            ethiopian.to_serial_date(toolbox::EthiopianCalendar::AD, 1, 1, 1),
+            1400000},
+        {&french, "FrenchRepublicanCalendar",
+            french.to_serial_date(toolbox::FrenchRepublicanCalendar::AD,
+                1, 1, 1), 14 * 365}
+    };
+    uint32_t state = 31337;
+    for (std::size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+        const toolbox::ICalendarSystem &calendar = *cases[c].calendar;
+        const std::size_t count = 1000;
+        std::vector<int> serials(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            serials[i] = cases[c].first_serial + static_cast<int>(
+                next_random(state) % static_cast<uint32_t>(cases[c].span));
+        }
+        std::vector<int> eras(count), years(count), months(count),
+            days(count);
+        calendar.from_serial_dates(&serials[0], count, &eras[0], &years[0],
+            &months[0], &days[0]);
+        std::vector<int> back(count);
+        calendar.to_serial_dates(&eras[0], &years[0], &months[0], &days[0],
+            count, &back[0]);
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            int era, year, month, day;
+            calendar.from_serial_date(serials[i], era, year, month, day);
+            if (era != eras[i] || year != years[i] || month != months[i]
+                || day != days[i] || back[i] != calendar.to_serial_date(
+                    eras[i], years[i], months[i], days[i])) {
+                ++mismatches;
+            }
+        }
+        const std::string name = cases[c].name;
+        check(mismatches == 0, name + ": batch conversions match");
+
+        eras.resize(3);
+        years.resize(3);
+        months.resize(3);
+        days.resize(3);
+        days[1] = 32;
+        const std::string expected = scalar_error(calendar, eras[1],
+            years[1], months[1], days[1]);
+        check(!expected.empty()
+            && batch_error(calendar, eras, years, months, days) == expected,
+            name + ": batch throws what the single conversion throws");
+    }
+}
+
+// "<date> HH:MM:SS" and "<date>THH:MM:SS" in and out, around the epoch and
+// the 2^31 seconds mark, and everything that is not a time of day.
+void test_timestamp_text() {
+    check(parses_timestamp("1970-01-01 00:00:00", 0), "Timestamp: epoch");
+    check(parses_timestamp("1969-12-31 23:59:59", -1),
+        "Timestamp: last second before the epoch");
+    check(parses_timestamp("1969-12-31T00:00:00", -86400),
+        "Timestamp: 'T' separator");
+    check(parses_timestamp("2038-01-19 03:14:08",
+        static_cast<int64_t>(2147483647) + 1), "Timestamp: 2^31 seconds");
+    check(parses_timestamp("2020-02-29 13:45:07", 1582983907),
+        "Timestamp: leap day");
+    check(parses_timestamp("1901-01-01 12:34:56",
+        -static_cast<int64_t>(2177407504u)), "Timestamp: 1901");
+
+    const char *invalid[] = {"", " 10:00:00", "2011-01-03",
+        "2011-01-03 24:00:00", "2011-01-03 12:60:00", "2011-01-03 12:00:60",
+        "2011-01-03 1:00:00", "2011-01-03x10:00:00", "2011-01-03 10-00-00",
+        "2011-02-30 10:00:00", "2011-13-01 10:00:00"};
+    for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        check(rejects_timestamp(invalid[i]),
+            std::string("Timestamp: rejects \"") + invalid[i] + "\"");
+    }
+    bool thrown = false;
+    try {
+        toolbox::Timestamp(toolbox::GREGORIAN, "2011-01-03 24:00:00",
+            toolbox::DateFormat("%Y-%m-%d"));
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    check(thrown, "Timestamp: parsing constructor throws");
+
+    // Any second from 1901 to about 2103 is written and read back the same.
+    uint32_t state = 2463534242u;
+    std::size_t mismatches = 0;
+    const toolbox::DateFormat format("%Y-%m-%d");
+    for (int i = 0; i < 5000; ++i) {
+        const toolbox::Timestamp time(
+            static_cast<int64_t>(next_random(state)) * 3 / 2
+            - static_cast<int64_t>(2177452800u));
+        toolbox::Timestamp parsed;
+        if (parsed.parse(toolbox::GREGORIAN,
+                time.to_string(toolbox::GREGORIAN), format).status
+                != toolbox::ParseResult::OK
+            || parsed != time) {
+            ++mismatches;
+        }
+    }
+    check(mismatches == 0, "Timestamp: to_string round trip");
+}
+
+// Date and time of day, floored before the epoch, and their limits.
+void test_timestamp_fields() {
+    const toolbox::Timestamp before(-1);
+    check(before.get_date().get_raw_date() == -1
+        && before.get_hour() == 23 && before.get_minute() == 59
+        && before.get_second() == 59
+        && before.get_seconds_of_day() == 86399,
+        "Timestamp: fields before the epoch");
+    const toolbox::Timestamp built(toolbox::Date(-1), 23, 59, 59);
+    check(built == before && built + 1 == toolbox::Timestamp(0)
+        && (built + 1).to_string(toolbox::GREGORIAN) == "1970-01-01 00:00:00",
+        "Timestamp: from a date and a time of day");
+    check(toolbox::Timestamp::day_of(86399) == 0
+        && toolbox::Timestamp::day_of(86400) == 1
+        && toolbox::Timestamp::day_of(-1) == -1
+        && toolbox::Timestamp::day_of(-86400) == -1
+        && toolbox::Timestamp::day_of(-86401) == -2
+        && toolbox::Timestamp::day_start(-2) == -172800,
+        "Timestamp: day_of and day_start");
+
+    toolbox::Timestamp moved(100);
+    moved += 50;
+    moved -= 20;
+    check(moved.get_raw_time() == 130 && moved - toolbox::Timestamp(30) == 100
+        && (moved - 130).get_raw_time() == 0
+        && toolbox::Timestamp(1) < moved && moved <= toolbox::Timestamp(130)
+        && moved > toolbox::Timestamp(-5) && moved >= toolbox::Timestamp(130)
+        && moved != toolbox::Timestamp(131),
+        "Timestamp: arithmetic and comparisons");
+
+    bool thrown = false;
+    try {
+        toolbox::Timestamp(toolbox::Date(0), 24, 0, 0);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    check(thrown, "Timestamp: hour 24 throws");
+    thrown = false;
+    try {
+        toolbox::Timestamp::day_of(static_cast<int64_t>(86400)
+            * (static_cast<int64_t>(2147483647) + 1));
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    check(thrown, "Timestamp: day_of past the last serial date throws");
+}
+
+bool parses_timestamp(const char *text, int64_t expected) {
+    const toolbox::DateFormat format("%Y-%m-%d");
+    toolbox::Timestamp time(12345);
+    return time.parse(toolbox::GREGORIAN, text, format).status
+            == toolbox::ParseResult::OK
+        && time.get_raw_time() == expected;
+}
+
+// True if text is rejected and the timestamp left alone.
+bool rejects_timestamp(const char *text) {
+    const toolbox::DateFormat format("%Y-%m-%d");
+    toolbox::Timestamp time(12345);
+    return time.parse(toolbox::GREGORIAN, text, format).status
+            != toolbox::ParseResult::OK
+        && time.get_raw_time() == 12345;
+}
+
+/*
+ * @brief Walks the valid dates of era from first_year to last_year (either
+ *        way), in calendar order: each must be the day after the previous
+ *        one (serial, unless INT_MIN) and convert back to itself.
+ * @return The number of dates that do not.
+ */
+std::size_t walk_dates(const toolbox::ICalendarSystem &calendar, int era,
+        int first_year, int last_year, int &serial) {
+    const int step = (first_year <= last_year) ? 1 : -1;
+    std::size_t mismatches = 0;
+    for (int year = first_year; year != last_year + step; year += step) {
+        for (int month = 1; month <= 13; ++month) {
+            for (int day = 1; day <= 31; ++day) {
+                if (!calendar.is_valid_date(era, year, month, day)) {
+                    continue;
+                }
+                const int next = calendar.to_serial_date(era, year, month,
+                    day);
+                int e, y, m, d;
+                calendar.from_serial_date(next, e, y, m, d);
+                if ((serial != INT_MIN && next != serial + 1) || e != era
+                    || y != year || m != month || d != day) {
+                    ++mismatches;
+                }
+                serial = next;
+            }
+        }
+    }
+    return mismatches;
+}
+
+// Serial dates drawn from [first_serial, last_serial] that do not convert
+// to a valid date and back.
+std::size_t round_trips(const toolbox::ICalendarSystem &calendar,
+        int first_serial, int last_serial, uint32_t seed) {
+    const uint32_t span = static_cast<uint32_t>(last_serial - first_serial)
+        + 1;
+    std::size_t mismatches = 0;
+    for (int i = 0; i < 20000; ++i) {
+        const int serial = first_serial
+            + static_cast<int>(next_random(seed) % span);
+        int era, year, month, day;
+        calendar.from_serial_date(serial, era, year, month, day);
+        if (!calendar.is_valid_date(era, year, month, day)
+            || calendar.to_serial_date(era, year, month, day) != serial) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// Type and message of what to_serial_date throws ("" if nothing).
+std::string scalar_error(const toolbox::ICalendarSystem &calendar, int era,
+        int year, int month, int day) {
+    try {
+        calendar.to_serial_date(era, year, month, day);
+    } catch (const std::exception &e) {
+        return std::string(typeid(e).name()) + ": " + e.what();
+    }
+    return "";
+}
+
+// Type and message of what to_serial_dates throws ("" if nothing).
+std::string batch_error(const toolbox::ICalendarSystem &calendar,
+        const std::vector<int> &eras, const std::vector<int> &years,
+        const std::vector<int> &months, const std::vector<int> &days) {
+    std::vector<int> serials(eras.size());
+    try {
+        calendar.to_serial_dates(&eras[0], &years[0], &months[0], &days[0],
+            eras.size(), &serials[0]);
+    } catch (const std::exception &e) {
+        return std::string(typeid(e).name()) + ": " + e.what();
+    }
+    return "";
+}
+}  // namespace
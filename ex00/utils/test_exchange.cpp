@@ -0,0 +1,366 @@
+#include <ex00/utils/test.hpp>
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ex00/BitcoinExchange.hpp>
+#include <ex00/Date.hpp>
+#include <ex00/MultiAssetExchange.hpp>
+#include <ex00/RateIndex.hpp>
+#include <toolbox/MappedFile.hpp>
+#include <toolbox/hash.hpp>
+
+namespace {
+void test_next_line();
+void test_multi_asset_duplicates();
+void test_reload();
+void test_snapshot();
+void test_batch_convert();
+bool converts_like_lookups(const BitcoinExchange &exchange,
+    const std::vector<BitcoinExchange::ConversionQuery> &queries);
+bool same_as_fresh_load(const BitcoinExchange &exchange,
+    const std::string &filename);
+bool same_rates(const BitcoinExchange &exchange,
+    const BitcoinExchange &expected);
+bool rejects_snapshot(const std::string &bytes);
+std::string read_test_file(const std::string &filename);
+double rate_on(const BitcoinExchange &exchange, const char *date);
+}  // namespace
+
+void test_exchange() {
+    test_next_line();
+    test_multi_asset_duplicates();
+    test_reload();
+    test_snapshot();
+    test_batch_convert();
+}
+
+namespace {
+// Lines come out as std::getline gives them: without their '\n', with a
+// last line that has none, and nothing after a final '\n'.
+void test_next_line() {
+    const std::string text = "a,1\n\nlast";
+    const char *cursor = text.data();
+    const char *const end = cursor + text.size();
+    const char *line_begin;
+    const char *line_end;
+    std::istringstream expected(text);
+    std::string line;
+    std::size_t lines = 0;
+    bool same = true;
+    while (toolbox::next_line(cursor, end, line_begin, line_end)) {
+        same = std::getline(expected, line)
+            && line == std::string(line_begin, line_end) && same;
+        ++lines;
+    }
+    check(same && lines == 3 && !std::getline(expected, line),
+        "next_line: splits like std::getline");
+
+    const std::string terminated = "x\n";
+    cursor = terminated.data();
+    check(toolbox::next_line(cursor, cursor + 2, line_begin, line_end)
+        && line_end - line_begin == 1
+        && !toolbox::next_line(cursor, terminated.data() + 2, line_begin,
+            line_end), "next_line: no empty line after a final newline");
+    cursor = NULL;
+    check(!toolbox::next_line(cursor, NULL, line_begin, line_end),
+        "next_line: empty range");
+}
+
+// A repeated date keeps the cells of its later rows, and is reported on
+// std::cerr the way BitcoinExchange reports one.
+void test_multi_asset_duplicates() {
+    write_test_file("btc_test_multi.csv", "date,btc,eth\n"
+        "2020-01-02,1,\n2020-01-01,5,6\n2020-01-02,,3\n");
+    std::ostringstream errors;
+    std::streambuf *cerr_buffer = std::cerr.rdbuf(errors.rdbuf());
+    MultiAssetExchange exchange("btc_test_multi.csv");
+    std::cerr.rdbuf(cerr_buffer);
+    std::remove("btc_test_multi.csv");
+
+    const toolbox::Date day(toolbox::GREGORIAN, "2020-01-02", "%Y-%m-%d");
+    check(exchange.size() == 2, "MultiAssetExchange: duplicate rows merged");
+    check(exchange.get_exchange_rate(exchange.asset_index("btc"), day) == 1.0
+        && exchange.get_exchange_rate(exchange.asset_index("eth"), day)
+            == 3.0, "MultiAssetExchange: merged cells");
+    check(errors.str() == "Warning: duplicate date entry in data file: "
+        "2020-01-02,,3 (the rate for this date will be overwritten)\n",
+        "MultiAssetExchange: duplicate reported on std::cerr");
+}
+
+// Whatever happened to the file since, a reload gives the rates a fresh
+// load would: after rows are appended, an unterminated last line is
+// completed, a row well before the end is edited in place (same file, same
+// size), the file is truncated, or it is replaced by another one.
+void test_reload() {
+    std::ostringstream rows;
+    toolbox::Date date(toolbox::GREGORIAN, "2013-01-01", "%Y-%m-%d");
+    for (int i = 1; i <= 400; ++i, ++date) {
+        rows << date.to_string(toolbox::GREGORIAN, "%Y-%m-%d") << "," << i
+            << "\n";
+    }
+    const std::string head = "date,exchange_rate\n2012-01-01,1\n"
+        "2012-01-03,2\n2012-01-07,3\n2012-01-09,4\n";
+    const std::string body = "2012-01-11,7.1\n" + rows.str();
+    write_test_file("btc_test_reload.csv", head + body);
+    BitcoinExchange exchange("btc_test_reload.csv");
+
+    write_test_file("btc_test_reload.csv", head + body + "2014-03-01,8\n");
+    exchange.reload_data("btc_test_reload.csv");
+    check(same_as_fresh_load(exchange, "btc_test_reload.csv")
+        && rate_on(exchange, "2014-03-20") == 8.0,
+        "BitcoinExchange: reload after rows are appended");
+
+    write_test_file("btc_test_reload.csv", head + body + "2014-03-01,8\n"
+        "2014-03-02,5");
+    exchange.reload_data("btc_test_reload.csv");
+    check(same_as_fresh_load(exchange, "btc_test_reload.csv")
+        && rate_on(exchange, "2014-03-02") == 5.0,
+        "BitcoinExchange: reload with an unterminated last line");
+    write_test_file("btc_test_reload.csv", head + body + "2014-03-01,8\n"
+        "2014-03-02,50\n2014-03-03,6\n");
+    exchange.reload_data("btc_test_reload.csv");
+    check(same_as_fresh_load(exchange, "btc_test_reload.csv")
+        && rate_on(exchange, "2014-03-02") == 50.0,
+        "BitcoinExchange: reload after the last line is completed");
+
+    std::string edited = head + body + "2014-03-01,8\n2014-03-02,50\n"
+        "2014-03-03,6\n";
+    edited[edited.find("2012-01-11,7.1") + 11] = '9';
+    write_test_file("btc_test_reload.csv", edited);
+    exchange.reload_data("btc_test_reload.csv");
+    check(same_as_fresh_load(exchange, "btc_test_reload.csv")
+        && rate_on(exchange, "2012-01-11") == 9.1,
+        "BitcoinExchange: reload after an edit in place");
+
+    write_test_file("btc_test_reload.csv", head);
+    exchange.reload_data("btc_test_reload.csv");
+    check(same_as_fresh_load(exchange, "btc_test_reload.csv")
+        && rate_on(exchange, "2014-03-20") == 4.0,
+        "BitcoinExchange: reload after truncation");
+
+    write_test_file("btc_test_reload.tmp", "date,exchange_rate\n"
+        "2012-01-02,11\n2012-01-05,12\n2013-01-08,13\n2013-01-10,14\n");
+    std::rename("btc_test_reload.tmp", "btc_test_reload.csv");
+    exchange.reload_data("btc_test_reload.csv");
+    check(same_as_fresh_load(exchange, "btc_test_reload.csv")
+        && rate_on(exchange, "2012-01-04") == 11.0,
+        "BitcoinExchange: reload after the file is replaced");
+    std::remove("btc_test_reload.csv");
+}
+
+// A snapshot restores the exact dates and rates it was saved from; a
+// missing, truncated, corrupted, foreign or unordered one is refused and
+// leaves the loaded history alone.
+void test_snapshot() {
+    std::ostringstream csv;
+    csv << "date,exchange_rate\n";
+    toolbox::Date date(toolbox::GREGORIAN, "2012-01-01", "%Y-%m-%d");
+    for (int i = 0; i < 101; ++i, date += 3) {
+        csv << date.to_string(toolbox::GREGORIAN, "%Y-%m-%d") << ","
+            << i * 0.37 << "\n";
+    }
+    write_test_file("btc_test_snapshot.csv", csv.str());
+    const BitcoinExchange saved("btc_test_snapshot.csv");
+    std::remove("btc_test_snapshot.csv");
+    saved.save_snapshot("btc_test.snapshot");
+    BitcoinExchange restored;
+    check(restored.load_snapshot("btc_test.snapshot")
+        && same_rates(restored, saved),
+        "BitcoinExchange: snapshot round trip");
+
+    std::vector<int> dates;
+    std::vector<double> rates;
+    for (int i = 0; i < 7; ++i) {
+        dates.push_back(-1000 + i * i * 50);
+        rates.push_back(1.0 / (i + 3));
+    }
+    RateIndex index;
+    std::vector<int> dates_copy(dates);
+    std::vector<double> rates_copy(rates);
+    index.assign(dates_copy, rates_copy);
+    index.write_snapshot("btc_test_index.snapshot");
+    RateIndex read;
+    read.read_snapshot("btc_test_index.snapshot");
+    std::remove("btc_test_index.snapshot");
+    check(read.size() == dates.size()
+        && std::memcmp(read.dates(), &dates[0],
+            dates.size() * sizeof(int)) == 0
+        && std::memcmp(read.rates(), &rates[0],
+            rates.size() * sizeof(double)) == 0,
+        "RateIndex: snapshot keeps the exact dates and rates");
+
+    const std::string bytes = read_test_file("btc_test.snapshot");
+    std::remove("btc_test.snapshot");
+    const std::size_t header = 32;
+    check(rejects_snapshot(bytes.substr(0, bytes.size() - 1))
+        && rejects_snapshot(bytes.substr(0, header - 1))
+        && rejects_snapshot(bytes + '\0'),
+        "BitcoinExchange: truncated snapshot refused");
+    std::string corrupted = bytes;
+    corrupted[header + 5] ^= 1;
+    check(rejects_snapshot(corrupted),
+        "BitcoinExchange: snapshot with a flipped byte refused");
+    corrupted = bytes;
+    corrupted[0] = 'X';
+    std::string version = bytes;
+    ++version[8];
+    check(rejects_snapshot(corrupted) && rejects_snapshot(version),
+        "BitcoinExchange: snapshot of another format refused");
+
+    // The first two dates swapped, under a checksum that matches.
+    std::string unordered = bytes;
+    for (std::size_t i = 0; i < sizeof(int32_t); ++i) {
+        std::swap(unordered[header + i],
+            unordered[header + sizeof(int32_t) + i]);
+    }
+    const uint64_t checksum = toolbox::hash::fnv1a(
+        unordered.data() + header, unordered.size() - header);
+    std::memcpy(&unordered[24], &checksum, sizeof(checksum));
+    check(rejects_snapshot(unordered),
+        "BitcoinExchange: snapshot with unordered dates refused");
+}
+
+// A batch of queries, sorted or not, with repeated dates and dates before
+// the history, gets what get_exchange_rate gives for each query, in the
+// order of the queries, with the index and with the dense table.
+void test_batch_convert() {
+    std::ostringstream csv;
+    csv << "date,exchange_rate\n";
+    toolbox::Date date(toolbox::GREGORIAN, "2012-03-01", "%Y-%m-%d");
+    uint32_t state = 2024;
+    for (int i = 0; i < 60; ++i) {
+        csv << date.to_string(toolbox::GREGORIAN, "%Y-%m-%d") << ","
+            << static_cast<double>(next_random(state) % 100000) / 100.0
+            << "\n";
+        date += 1 + static_cast<int>(next_random(state) % 9);
+    }
+    write_test_file("btc_test_batch.csv", csv.str());
+    BitcoinExchange exchange("btc_test_batch.csv");
+    std::remove("btc_test_batch.csv");
+
+    const toolbox::Date before(toolbox::GREGORIAN, "2012-02-20", "%Y-%m-%d");
+    std::vector<BitcoinExchange::ConversionQuery> queries;
+    for (int i = 0; i < 400; ++i) {
+        BitcoinExchange::ConversionQuery query;
+        query.date = before + static_cast<int>(next_random(state) % 400);
+        query.amount = static_cast<double>(next_random(state) % 1000) / 10.0;
+        queries.push_back(query);
+        if (i % 10 == 0) {
+            queries.push_back(query);  // the same date again, right away
+        }
+    }
+    BitcoinExchange::ConversionQuery first = {before, 3.0};
+    queries.push_back(first);
+    std::vector<BitcoinExchange::ConversionQuery> sorted(queries);
+    for (std::size_t i = 1; i < sorted.size(); ++i) {
+        for (std::size_t j = i; j > 0 && sorted[j].date < sorted[j - 1].date;
+            --j) {
+            std::swap(sorted[j], sorted[j - 1]);
+        }
+    }
+    check(converts_like_lookups(exchange, queries)
+        && converts_like_lookups(exchange, sorted)
+        && exchange.convert(
+            std::vector<BitcoinExchange::ConversionQuery>()).empty(),
+        "BitcoinExchange: convert agrees with get_exchange_rate");
+    exchange.set_lookup_mode(BitcoinExchange::DENSE_TABLE);
+    check(converts_like_lookups(exchange, queries)
+        && converts_like_lookups(exchange, sorted),
+        "BitcoinExchange: convert agrees with the dense table");
+}
+
+// True if convert gives, for each of queries, the rate get_exchange_rate
+// gives and amount * rate, or found false and zeros if it throws.
+bool converts_like_lookups(const BitcoinExchange &exchange,
+        const std::vector<BitcoinExchange::ConversionQuery> &queries) {
+    const std::vector<BitcoinExchange::ConversionResult> results
+        = exchange.convert(queries);
+    if (results.size() != queries.size()) {
+        return false;
+    }
+    std::size_t not_found = 0;
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        const BitcoinExchange::ConversionResult &result = results[i];
+        try {
+            const double rate = exchange.get_exchange_rate(queries[i].date);
+            if (!result.found || result.rate != rate
+                || result.value != queries[i].amount * rate) {
+                return false;
+            }
+        } catch (const std::out_of_range &) {
+            if (result.found || result.rate != 0.0 || result.value != 0.0) {
+                return false;
+            }
+            ++not_found;
+        }
+    }
+    return not_found != 0 && not_found != queries.size();
+}
+
+// True if exchange has the rates of a fresh load of filename.
+bool same_as_fresh_load(const BitcoinExchange &exchange,
+        const std::string &filename) {
+    return same_rates(exchange, BitcoinExchange(filename));
+}
+
+// True if exchange and expected have the same rate (or none) on every day
+// from 2011-12-30, before any of the test histories, to 2014-04-30.
+bool same_rates(const BitcoinExchange &exchange,
+        const BitcoinExchange &expected) {
+    toolbox::Date date(toolbox::GREGORIAN, "2011-12-30", "%Y-%m-%d");
+    const toolbox::Date last(toolbox::GREGORIAN, "2014-04-30", "%Y-%m-%d");
+    for (; date <= last; ++date) {
+        double expected_rate = -1.0;
+        double rate = -1.0;
+        try {
+            expected_rate = expected.get_exchange_rate(date);
+        } catch (const std::out_of_range &) {
+        }
+        try {
+            rate = exchange.get_exchange_rate(date);
+        } catch (const std::out_of_range &) {
+        }
+        if (rate != expected_rate) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double rate_on(const BitcoinExchange &exchange, const char *date) {
+    return exchange.get_exchange_rate(
+        toolbox::Date(toolbox::GREGORIAN, date, "%Y-%m-%d"));
+}
+
+// True if bytes, as a snapshot file, are refused by load_snapshot without
+// touching the history already loaded.
+bool rejects_snapshot(const std::string &bytes) {
+    write_test_file("btc_test_bad.csv", "date,exchange_rate\n2012-05-01,3\n");
+    BitcoinExchange exchange("btc_test_bad.csv");
+    const BitcoinExchange before("btc_test_bad.csv");
+    std::remove("btc_test_bad.csv");
+    write_test_file("btc_test_bad.snapshot", bytes);
+    const bool loaded = exchange.load_snapshot("btc_test_bad.snapshot");
+    std::remove("btc_test_bad.snapshot");
+    return !loaded && same_rates(exchange, before)
+        && !exchange.load_snapshot("btc_test_missing.snapshot");
+}
+
+std::string read_test_file(const std::string &filename) {
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>());
+}
+}  // namespace
@@ -0,0 +1,20 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <ex00/utils/test.hpp>
+#include <toolbox/StepMark.hpp>
+
+int main() {
+    toolbox::logger::StepMark::setLogFile("btc_test.log");
+    toolbox::logger::StepMark::setLevel(toolbox::logger::WARNING);
+    try {
+        test();
+    } catch (const std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        toolbox::logger::StepMark::error(std::string(
+            "test: exception: ") + e.what());
+        return 1;
+    }
+    return test_failures() == 0 ? 0 : 1;
+}
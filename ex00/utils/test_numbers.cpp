@@ -0,0 +1,240 @@
+#include <ex00/utils/test.hpp>
+
+#include <stdint.h>
+
+#include <cfloat>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <toolbox/string.hpp>
+
+namespace {
+void test_parse_int();
+void test_parse_double();
+void test_format_double();
+bool formats(double value, const char *expected);
+bool formats(double value, int precision, const char *expected);
+bool parses_int(const char *text, int expected);
+bool rejects_int(const char *text);
+bool parses_double(const char *text, double expected);
+bool rejects_double(const char *text);
+bool same_bits(double a, double b);
+double random_double(uint32_t &state);
+}  // namespace
+
+void test_numbers() {
+    test_parse_int();
+    test_parse_double();
+    test_format_double();
+}
+
+namespace {
+void test_parse_int() {
+    check(parses_int("0", 0), "parse_int: 0");
+    check(parses_int("42", 42), "parse_int: 42");
+    check(parses_int("-42", -42), "parse_int: -42");
+    check(parses_int("+7", 7), "parse_int: +7");
+    check(parses_int(" \t12", 12), "parse_int: leading white space");
+    check(parses_int("0000000000000000000042", 42),
+        "parse_int: leading zeros");
+    check(parses_int("2147483647", INT_MAX), "parse_int: INT_MAX");
+    check(parses_int("-2147483648", INT_MIN), "parse_int: INT_MIN");
+
+    const char *invalid[] = {"", " ", "+", "-", "+-1", "12a", "1.0", "12 ",
+        "0x10", "2147483648", "-2147483649", "99999999999999999999"};
+    for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        check(rejects_int(invalid[i]),
+            std::string("parse_int: rejects \"") + invalid[i] + "\"");
+    }
+
+    check(toolbox::stoi("-17") == -17, "stoi: -17");
+    bool thrown = false;
+    try {
+        toolbox::stoi("2147483648");
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    check(thrown, "stoi: throws past INT_MAX");
+}
+
+void test_parse_double() {
+    check(parses_double("0", 0.0), "parse_double: 0");
+    check(parses_double("0.3", 0.3), "parse_double: 0.3");
+    check(parses_double("47115.93", 47115.93), "parse_double: 47115.93");
+    check(parses_double("-1.5", -1.5), "parse_double: -1.5");
+    check(parses_double("+.5", 0.5), "parse_double: +.5");
+    check(parses_double("5.", 5.0), "parse_double: 5.");
+    check(parses_double(" 1e3", 1000.0), "parse_double: white space, 1e3");
+    check(parses_double("2.5E-3", 0.0025), "parse_double: 2.5E-3");
+    check(parses_double("-0", -0.0), "parse_double: -0 keeps its sign");
+    // Around the limits of the exact (single operation) path.
+    check(parses_double("9007199254740992", 9007199254740992.0),
+        "parse_double: 2^53");
+    check(parses_double("9007199254740993", 9007199254740992.0),
+        "parse_double: 2^53 + 1 rounds to even");
+    check(parses_double("1e22", 1e22), "parse_double: 1e22");
+    check(parses_double("1e23", 1e23), "parse_double: 1e23");
+    check(parses_double("1.7976931348623157e308", DBL_MAX),
+        "parse_double: DBL_MAX");
+    check(parses_double("2.2250738585072014e-308", DBL_MIN),
+        "parse_double: DBL_MIN");
+    check(parses_double("4.9406564584124654e-324", 4.9406564584124654e-324),
+        "parse_double: smallest subnormal");
+    check(parses_double("1e-400", 0.0), "parse_double: underflow is 0");
+
+    const char *invalid[] = {"", " ", ".", "-", "e5", "1e", "1e+", "1.2.3",
+        "1,5", "1 ", "inf", "nan", "0x10", "1e309", "-1e309",
+        "1.8e308"};
+    for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        check(rejects_double(invalid[i]),
+            std::string("parse_double: rejects \"") + invalid[i] + "\"");
+    }
+
+    bool thrown = false;
+    try {
+        toolbox::stod("1e309");
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    check(thrown, "stod: throws on overflow");
+
+    // Round trip of random values written with 17 digits, and agreement
+    // with strtod on short decimals (the fast path).
+    uint32_t state = 0x9E3779B9u;
+    std::size_t round_trip_errors = 0;
+    std::size_t short_errors = 0;
+    for (int i = 0; i < 20000; ++i) {
+        const double value = random_double(state);
+        char text[64];
+        std::sprintf(text, "%.17g", value);
+        double parsed = 0.0;
+        if (!toolbox::parse_double(text, std::strlen(text), parsed)
+            || !same_bits(parsed, value)) {
+            ++round_trip_errors;
+        }
+        std::sprintf(text, "%.*f", static_cast<int>(next_random(state) % 9),
+            static_cast<double>(next_random(state) % 100000000) / 100.0);
+        if (!toolbox::parse_double(text, std::strlen(text), parsed)
+            || !same_bits(parsed, std::strtod(text, NULL))) {
+            ++short_errors;
+        }
+    }
+    check(round_trip_errors == 0, "parse_double: reads back %.17g");
+    check(short_errors == 0, "parse_double: agrees with strtod");
+}
+
+void test_format_double() {
+    check(formats(0.0, "0"), "format_double: 0");
+    check(formats(-0.0, "-0"), "format_double: -0");
+    check(formats(0.3, "0.3"), "format_double: 0.3");
+    check(formats(47115.93, "47115.93"), "format_double: 47115.93");
+    check(formats(-2.5e-7, "-2.5e-07"), "format_double: -2.5e-07");
+    check(formats(1e21, "1e+21"), "format_double: 1e+21");
+    check(formats(123456789012345680.0, "1.2345678901234568e+17"),
+        "format_double: 17 digits");
+    check(formats(DBL_MAX, "1.7976931348623157e+308"),
+        "format_double: DBL_MAX");
+    check(formats(4.9406564584124654e-324, "5e-324"),
+        "format_double: smallest subnormal");
+
+    check(formats(0.1, 6, "0.1"), "format_double: 0.1, precision 6");
+    check(formats(1234567.0, 6, "1.23457e+06"),
+        "format_double: 1234567, precision 6");
+    check(formats(0.0001, 6, "0.0001"), "format_double: 0.0001");
+    check(formats(0.00001, 6, "1e-05"), "format_double: 1e-05");
+    check(formats(999999.5, 6, "1e+06"), "format_double: carry to 1e+06");
+    check(formats(2.5, 1, "2"), "format_double: midpoint to even");
+    check(formats(1.0 / 3.0, 0, "0.3"), "format_double: precision 0 is 1");
+    check(formats(1.0 / 3.0, 40, "0.33333333333333331"),
+        "format_double: precision above 17 is 17");
+    check(formats(-1.0 / 0.0, 6, "-inf"), "format_double: -inf");
+
+    // Random values: the shortest text reads back as the same double, is no
+    // longer than %.17g, and every precision matches printf.
+    uint32_t state = 0x2545F491u;
+    std::size_t round_trip_errors = 0;
+    std::size_t printf_errors = 0;
+    for (int i = 0; i < 20000; ++i) {
+        const double value = (i % 2 == 0) ? random_double(state)
+            : static_cast<double>(next_random(state) % 10000000) / 100.0;
+        char text[toolbox::DOUBLE_BUFFER_SIZE];
+        char expected[64];
+        const std::size_t length = toolbox::format_double(value, text);
+        double parsed = 0.0;
+        std::sprintf(expected, "%.17g", value);
+        if (length != std::strlen(text) || length > std::strlen(expected)
+            || !toolbox::parse_double(text, length, parsed)
+            || !same_bits(parsed, value)) {
+            ++round_trip_errors;
+        }
+        const int precision = 1 + static_cast<int>(next_random(state) % 17);
+        toolbox::format_double(value, text, precision);
+        std::sprintf(expected, "%.*g", precision, value);
+        if (std::strcmp(text, expected) != 0) {
+            ++printf_errors;
+        }
+    }
+    check(round_trip_errors == 0, "format_double: shortest round trip");
+    check(printf_errors == 0, "format_double: matches printf %.*g");
+}
+
+bool formats(double value, const char *expected) {
+    char text[toolbox::DOUBLE_BUFFER_SIZE];
+    return toolbox::format_double(value, text) == std::strlen(expected)
+        && std::strcmp(text, expected) == 0;
+}
+
+bool formats(double value, int precision, const char *expected) {
+    char text[toolbox::DOUBLE_BUFFER_SIZE];
+    return toolbox::format_double(value, text, precision)
+        == std::strlen(expected) && std::strcmp(text, expected) == 0;
+}
+
+// True if text parses to exactly expected.
+bool parses_int(const char *text, int expected) {
+    int value = ~expected;  // differs from expected, without overflow
+    return toolbox::parse_int(text, std::strlen(text), value)
+        && value == expected;
+}
+
+// True if text is rejected and the output is left alone.
+bool rejects_int(const char *text) {
+    int value = 12345;
+    return !toolbox::parse_int(text, std::strlen(text), value)
+        && value == 12345;
+}
+
+bool parses_double(const char *text, double expected) {
+    double value = 12345.0;
+    return toolbox::parse_double(text, std::strlen(text), value)
+        && same_bits(value, expected);
+}
+
+bool rejects_double(const char *text) {
+    double value = 12345.0;
+    return !toolbox::parse_double(text, std::strlen(text), value)
+        && value == 12345.0;
+}
+
+bool same_bits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// A random finite double, any exponent and sign.
+double random_double(uint32_t &state) {
+    for (;;) {
+        const uint64_t high = next_random(state);
+        const uint64_t bits = (high << 32) | next_random(state);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (value == value && value - value == 0.0) {
+            return value;
+        }
+    }
+}
+}  // namespace
@@ -0,0 +1,487 @@
+#include <ex00/utils/test.hpp>
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ex00/BitcoinExchange.hpp>
+#include <ex00/CompressedRates.hpp>
+#include <ex00/Date.hpp>
+#include <ex00/RateAggregates.hpp>
+#include <ex00/RateIndex.hpp>
+#include <ex00/TickIndex.hpp>
+
+namespace {
+// Threads making the first range query of an exchange at the same time.
+struct RangeQuery {
+    const BitcoinExchange *exchange;
+    toolbox::Date from;
+    toolbox::Date to;
+    double max;
+};
+
+void test_aggregates();
+void test_exchange_ranges();
+void test_tick_index();
+void test_compressed_rates();
+void test_lookup_modes();
+void compressed_history(std::size_t size, uint32_t &state,
+    RateIndex &index);
+bool compressed_matches(const CompressedRates &compressed,
+    const RateIndex &index, int serial_date);
+bool tick_matches(const TickIndex &ticks,
+    const std::map<int64_t, double> &reference, int64_t time);
+bool aggregates_match(const RateAggregates &aggregates,
+    const std::vector<double> &rates, std::size_t first, std::size_t last);
+void random_index(std::size_t size, uint32_t &state, RateIndex &index,
+    std::vector<double> &rates);
+void *query_max(void *arg);
+toolbox::Date gregorian(const char *text);
+}  // namespace
+
+void test_rates() {
+    test_aggregates();
+    test_exchange_ranges();
+    test_tick_index();
+    test_compressed_rates();
+    test_lookup_modes();
+}
+
+namespace {
+// Every range of small indexes, and random ranges of larger ones, around
+// the block size of the sparse table.
+void test_aggregates() {
+    const std::size_t sizes[] = {0, 1, 2, 31, 32, 33, 64, 65, 100, 1000,
+        5000};
+    uint32_t state = 12345;
+    std::size_t mismatches = 0;
+    for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        RateIndex index;
+        std::vector<double> rates;
+        random_index(sizes[s], state, index, rates);
+        RateAggregates aggregates;
+        aggregates.build(index);
+        if (aggregates.size() != sizes[s]) {
+            ++mismatches;
+        }
+        if (aggregates.sum(0, 0) != 0.0) {
+            ++mismatches;
+        }
+        if (sizes[s] <= 100) {
+            for (std::size_t first = 0; first < sizes[s]; ++first) {
+                for (std::size_t last = first + 1; last <= sizes[s]; ++last) {
+                    mismatches += !aggregates_match(aggregates, rates, first,
+                        last);
+                }
+            }
+        } else {
+            for (int i = 0; i < 2000; ++i) {
+                std::size_t first = next_random(state) % sizes[s];
+                std::size_t last = next_random(state) % sizes[s] + 1;
+                if (first >= last) {
+                    std::swap(first, last);
+                    ++last;
+                }
+                mismatches += !aggregates_match(aggregates, rates, first,
+                    std::min(last, sizes[s]));
+            }
+            mismatches += !aggregates_match(aggregates, rates, 0, sizes[s]);
+        }
+    }
+    check(mismatches == 0, "RateAggregates: sum, min, max of ranges");
+
+    RateAggregates cleared;
+    RateIndex index;
+    std::vector<double> rates;
+    random_index(10, state, index, rates);
+    cleared.build(index);
+    cleared.clear();
+    check(cleared.size() == 0, "RateAggregates: clear");
+}
+
+// Date ranges are inclusive, checked, and follow reloads and copies.
+void test_exchange_ranges() {
+    write_test_file("btc_test_ranges.csv", "date,exchange_rate\n"
+        "2020-01-01,4\n2020-01-03,2\n2020-01-05,8\n2020-01-09,6\n");
+    BitcoinExchange exchange("btc_test_ranges.csv");
+    const toolbox::Date jan1 = gregorian("2020-01-01");
+    const toolbox::Date jan3 = gregorian("2020-01-03");
+    const toolbox::Date jan4 = gregorian("2020-01-04");
+    const toolbox::Date jan9 = gregorian("2020-01-09");
+    const toolbox::Date jan31 = gregorian("2020-01-31");
+    check(exchange.get_rate_sum(jan1, jan9) == 20.0,
+        "BitcoinExchange: sum over the whole history");
+    check(exchange.get_min_rate(jan3, jan9) == 2.0
+        && exchange.get_max_rate(jan1, jan4) == 4.0,
+        "BitcoinExchange: min and max include both ends");
+    check(exchange.get_mean_rate(jan4, jan31) == 7.0,
+        "BitcoinExchange: mean");
+    check(exchange.get_rate_sum(gregorian("2019-12-01"),
+        gregorian("2019-12-31")) == 0.0,
+        "BitcoinExchange: sum of an empty range");
+    bool thrown = false;
+    try {
+        exchange.get_min_rate(gregorian("2020-01-06"),
+            gregorian("2020-01-08"));
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    check(thrown, "BitcoinExchange: min of an empty range throws");
+    thrown = false;
+    try {
+        exchange.get_rate_sum(jan9, jan1);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    check(thrown, "BitcoinExchange: reversed range throws");
+
+    const BitcoinExchange copy(exchange);
+    check(copy.get_max_rate(jan1, jan9) == 8.0,
+        "BitcoinExchange: a copy answers range queries");
+    write_test_file("btc_test_ranges.csv", "date,exchange_rate\n"
+        "2020-01-01,1\n2020-01-02,3\n");
+    exchange.load_data("btc_test_ranges.csv");
+    std::remove("btc_test_ranges.csv");
+    check(exchange.get_max_rate(jan1, jan31) == 3.0
+        && copy.get_max_rate(jan1, jan31) == 8.0,
+        "BitcoinExchange: aggregates follow a reload");
+
+    // The first range query may come from several threads at once.
+    std::ostringstream csv;
+    csv << "date,exchange_rate\n";
+    for (int day = 1; day <= 28; ++day) {
+        csv << "2021-02-" << (day < 10 ? "0" : "") << day << "," << day
+            << "\n";
+    }
+    write_test_file("btc_test_ranges.csv", csv.str());
+    const BitcoinExchange shared("btc_test_ranges.csv");
+    std::remove("btc_test_ranges.csv");
+    RangeQuery queries[4];
+    pthread_t threads[4];
+    int started = 0;
+    for (; started < 4; ++started) {
+        queries[started].exchange = &shared;
+        queries[started].from = gregorian("2021-02-01");
+        queries[started].to = gregorian("2021-02-28");
+        queries[started].max = 0.0;
+        if (::pthread_create(&threads[started], NULL, query_max,
+                &queries[started]) != 0) {
+            break;
+        }
+    }
+    bool same = (started == 4);
+    for (int i = 0; i < started; ++i) {
+        ::pthread_join(threads[i], NULL);
+        same = same && queries[i].max == 28.0;
+    }
+    check(same, "BitcoinExchange: concurrent first range queries");
+}
+
+// Random tick histories against a map: bursts of one-second ticks (many
+// groups a day), gaps past a group's 65535-second reach, days without
+// ticks, and times on both sides of the epoch.
+void test_tick_index() {
+    uint32_t state = 424242;
+    std::size_t mismatches = 0;
+    for (int history = 0; history < 20; ++history) {
+        TickIndex ticks;
+        std::map<int64_t, double> reference;
+        int64_t time = -static_cast<int64_t>(next_random(state) % 400000);
+        const std::size_t count = next_random(state) % 3000;
+        for (std::size_t i = 0; i < count; ++i) {
+            const uint32_t kind = next_random(state) % 16;
+            if (kind < 10) {
+                time += 1;
+            } else if (kind < 13) {
+                time += next_random(state) % 1000;
+            } else if (kind < 15) {
+                time += 65000 + next_random(state) % 1000;
+            } else {
+                time += next_random(state) % (5 * 86400);
+            }
+            const double rate = static_cast<double>(next_random(state)
+                % 100000) / 100.0;
+            mismatches += !ticks.append(time, rate);
+            reference[time] = rate;
+        }
+        if (ticks.size() != reference.size()
+            || (count != 0 && (ticks.first_time() != reference.begin()->first
+                || ticks.last_time() != reference.rbegin()->first))) {
+            ++mismatches;
+        }
+        for (std::map<int64_t, double>::const_iterator it = reference.begin();
+            it != reference.end(); ++it) {
+            mismatches += !tick_matches(ticks, reference, it->first - 1);
+            mismatches += !tick_matches(ticks, reference, it->first);
+            mismatches += !tick_matches(ticks, reference, it->first + 1);
+        }
+        const int64_t first = reference.empty() ? 0
+            : reference.begin()->first;
+        for (int i = 0; i < 2000; ++i) {
+            mismatches += !tick_matches(ticks, reference, first - 100000
+                + static_cast<int64_t>(next_random(state) % 10000000));
+        }
+    }
+    check(mismatches == 0, "TickIndex: as-of lookups");
+
+    TickIndex ticks;
+    double rate = 0.0;
+    check(ticks.empty() && !ticks.find(0, rate) && ticks.first_time() == 0
+        && ticks.last_time() == 0, "TickIndex: empty");
+    ticks.append(-86400, 1.0);
+    ticks.append(100, 2.0);
+    check(ticks.append(100, 3.0) && ticks.size() == 2
+        && ticks.find(100, rate) && rate == 3.0,
+        "TickIndex: a tick at the last time replaces its rate");
+    check(!ticks.append(99, 4.0) && ticks.size() == 2
+        && ticks.last_time() == 100 && ticks.find(1000, rate) && rate == 3.0,
+        "TickIndex: out-of-order tick refused");
+    check(!ticks.find(-86401, rate) && ticks.find(-86400, rate) && rate == 1.0
+        && ticks.find(99, rate) && rate == 1.0,
+        "TickIndex: before, at and after the first tick");
+    const TickIndex copy(ticks);
+    ticks.clear();
+    check(ticks.empty() && ticks.size() == 0 && !ticks.find(100, rate)
+        && copy.size() == 2 && copy.first_time() == -86400,
+        "TickIndex: clear");
+}
+
+// True if ticks and reference agree on the rate in effect at time.
+bool tick_matches(const TickIndex &ticks,
+        const std::map<int64_t, double> &reference, int64_t time) {
+    std::map<int64_t, double>::const_iterator it = reference.upper_bound(time);
+    double rate = -1.0;
+    if (it == reference.begin()) {
+        return !ticks.find(time, rate);
+    }
+    --it;
+    return ticks.find(time, rate) && rate == it->second;
+}
+
+// Random histories against the rate index they are packed from, around
+// the block size, with date gaps in every delta-of-delta bucket and rate
+// changes of every XOR width.
+void test_compressed_rates() {
+    const std::size_t block = CompressedRates::BLOCK_SIZE;
+    const std::size_t sizes[] = {0, 1, block - 1, block, block + 1,
+        5 * block + 3, 3000};
+    uint32_t state = 777;
+    std::size_t mismatches = 0;
+    for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        for (int history = 0; history < 4; ++history) {
+            RateIndex index;
+            compressed_history(sizes[s], state, index);
+            CompressedRates compressed;
+            compressed.build(index);
+            if (compressed.size() != sizes[s]
+                || compressed.empty() != (sizes[s] == 0)) {
+                ++mismatches;
+            }
+            const int *dates = index.dates();
+            for (std::size_t i = 0; i < index.size(); ++i) {
+                mismatches += !compressed_matches(compressed, index,
+                    dates[i] - 1);
+                mismatches += !compressed_matches(compressed, index,
+                    dates[i]);
+                mismatches += !compressed_matches(compressed, index,
+                    dates[i] + 1);
+            }
+            if (index.size() != 0) {
+                const int first = dates[0];
+                const int span = dates[index.size() - 1] - first + 1;
+                for (int i = 0; i < 500; ++i) {
+                    mismatches += !compressed_matches(compressed, index,
+                        first + static_cast<int>(next_random(state)
+                            % static_cast<uint32_t>(span)));
+                }
+            }
+            mismatches += !compressed_matches(compressed, index,
+                std::numeric_limits<int>::min());
+            mismatches += !compressed_matches(compressed, index,
+                std::numeric_limits<int>::max());
+        }
+    }
+    check(mismatches == 0, "CompressedRates: as-of lookups");
+
+    RateIndex index;
+    compressed_history(100, state, index);
+    CompressedRates compressed;
+    compressed.build(index);
+    const CompressedRates copy(compressed);
+    compressed.clear();
+    double rate = 0.0;
+    check(compressed.empty() && compressed.size() == 0
+        && !compressed.find(index.dates()[0], rate)
+        && copy.size() == 100 && copy.find(index.dates()[99], rate)
+        && rate == index.rates()[99], "CompressedRates: clear");
+}
+
+// The three lookup modes of an exchange give the same rates, on a dense
+// history and on one too sparse for the day-indexed table.
+void test_lookup_modes() {
+    const BitcoinExchange::LookupMode modes[] = {
+        BitcoinExchange::BINARY_SEARCH, BitcoinExchange::DENSE_TABLE,
+        BitcoinExchange::COMPRESSED};
+    const int gaps[] = {3, 400};
+    uint32_t state = 99;
+    for (std::size_t g = 0; g < sizeof(gaps) / sizeof(gaps[0]); ++g) {
+        std::ostringstream csv;
+        csv.precision(17);
+        csv << "date,exchange_rate\n";
+        int date = 10000;
+        const int first = date;
+        for (int i = 0; i < 500; ++i) {
+            csv << toolbox::Date(date).to_string(toolbox::GREGORIAN,
+                    "%Y-%m-%d")
+                << "," << static_cast<double>(next_random(state) % 10000000)
+                    / 1000.0 << "\n";
+            date += 1 + static_cast<int>(next_random(state)
+                % static_cast<uint32_t>(gaps[g]));
+        }
+        write_test_file("btc_test_modes.csv", csv.str());
+        BitcoinExchange exchanges[3];
+        for (int m = 0; m < 3; ++m) {
+            exchanges[m].set_lookup_mode(modes[m]);
+            exchanges[m].load_data("btc_test_modes.csv");
+        }
+        std::remove("btc_test_modes.csv");
+        std::size_t mismatches = 0;
+        for (int day = first - 2; day < date + 2; ++day) {
+            double rates[3];
+            bool found[3];
+            for (int m = 0; m < 3; ++m) {
+                try {
+                    rates[m] = exchanges[m].get_exchange_rate(
+                        toolbox::Date(day));
+                    found[m] = true;
+                } catch (const std::out_of_range &) {
+                    rates[m] = 0.0;
+                    found[m] = false;
+                }
+            }
+            mismatches += found[0] != found[1] || found[0] != found[2]
+                || rates[0] != rates[1] || rates[0] != rates[2]
+                || found[0] != (day >= first);
+        }
+        check(mismatches == 0, "BitcoinExchange: lookup modes agree");
+    }
+}
+
+// An index of size entries whose dates step by one day, a few days, and
+// jumps that need each wider delta-of-delta code, and whose rates repeat,
+// change in their last bits, or change sign and magnitude entirely
+// (zeros, extremes and subnormals).
+void compressed_history(std::size_t size, uint32_t &state,
+        RateIndex &index) {
+    const double specials[] = {0.0, -0.0, 1.0, -1.0,
+        std::numeric_limits<double>::max(),
+        -std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::min(),
+        std::numeric_limits<double>::denorm_min(),
+        -std::numeric_limits<double>::denorm_min(), 1e-300, 123456.789};
+    std::vector<int> dates;
+    std::vector<double> rates;
+    int date = -200000000;
+    double rate = 1000.0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const uint32_t step = next_random(state) % 16;
+        if (step < 8) {
+            date += 1;
+        } else if (step < 11) {
+            date += 2 + static_cast<int>(next_random(state) % 60);
+        } else if (step < 13) {
+            date += 100 + static_cast<int>(next_random(state) % 2000);
+        } else if (step < 15) {
+            date += 3000 + static_cast<int>(next_random(state) % 500000);
+        } else {
+            date += 600000 + static_cast<int>(next_random(state) % 400000);
+        }
+        dates.push_back(date);
+        const uint32_t change = next_random(state) % 8;
+        if (change < 3) {
+            // unchanged
+        } else if (change < 5) {
+            uint64_t bits;
+            std::memcpy(&bits, &rate, sizeof(bits));
+            bits ^= static_cast<uint64_t>(next_random(state) % 256)
+                << (next_random(state) % 48);
+            std::memcpy(&rate, &bits, sizeof(rate));
+            if (rate != rate) {
+                rate = 2.5;
+            }
+        } else if (change < 7) {
+            rate = specials[next_random(state)
+                % (sizeof(specials) / sizeof(specials[0]))];
+        } else {
+            rate = (static_cast<double>(next_random(state)) - 2147483648.0)
+                * 1e-3;
+        }
+        rates.push_back(rate);
+    }
+    index.assign(dates, rates);
+}
+
+// True if compressed and index agree, bit for bit, on the rate in effect
+// on serial_date.
+bool compressed_matches(const CompressedRates &compressed,
+        const RateIndex &index, int serial_date) {
+    double expected = 0.0;
+    double rate = 0.0;
+    const bool found = index.find(serial_date, expected);
+    if (compressed.find(serial_date, rate) != found) {
+        return false;
+    }
+    return !found || std::memcmp(&rate, &expected, sizeof(rate)) == 0;
+}
+
+bool aggregates_match(const RateAggregates &aggregates,
+        const std::vector<double> &rates, std::size_t first,
+        std::size_t last) {
+    double sum = 0.0;
+    for (std::size_t i = first; i < last; ++i) {
+        sum += rates[i];
+    }
+    const double difference = aggregates.sum(first, last) - sum;
+    return (difference < 0.0 ? -difference : difference) <= 1e-9 * sum
+        && aggregates.min(first, last)
+            == *std::min_element(&rates[0] + first, &rates[0] + last)
+        && aggregates.max(first, last)
+            == *std::max_element(&rates[0] + first, &rates[0] + last);
+}
+
+// An index of size entries one to three days apart, with random rates.
+void random_index(std::size_t size, uint32_t &state, RateIndex &index,
+        std::vector<double> &rates) {
+    std::vector<int> dates;
+    rates.clear();
+    int date = 14000;
+    for (std::size_t i = 0; i < size; ++i) {
+        date += 1 + static_cast<int>(next_random(state) % 3);
+        dates.push_back(date);
+        rates.push_back(static_cast<double>(next_random(state) % 1000000)
+            / 100.0);
+    }
+    std::vector<double> copy(rates);
+    index.assign(dates, copy);
+}
+
+void *query_max(void *arg) {
+    RangeQuery &query = *static_cast<RangeQuery *>(arg);
+    query.max = query.exchange->get_max_rate(query.from, query.to);
+    return NULL;
+}
+
+toolbox::Date gregorian(const char *text) {
+    return toolbox::Date(toolbox::GREGORIAN, text, "%Y-%m-%d");
+}
+}  // namespace
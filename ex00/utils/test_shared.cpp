@@ -0,0 +1,148 @@
+#include <ex00/utils/test.hpp>
+
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <ex00/BitcoinExchange.hpp>
+#include <ex00/Date.hpp>
+#include <ex00/SharedExchange.hpp>
+
+namespace {
+const int reader_count = 4;
+const uint64_t publish_count = 2000;
+
+// What a reader thread saw.
+struct ReaderRun {
+    SharedExchange *shared;
+    const int *stop;
+    int *ready;                  // readers that have read at least once
+    toolbox::Date date;
+    std::size_t reads;
+    std::size_t torn_reads;      // rate not the one of the pinned version
+    std::size_t backward_reads;  // version lower than one seen before
+};
+
+void test_concurrent_publish();
+void *read_until_stopped(void *arg);
+}  // namespace
+
+void test_shared() {
+    test_concurrent_publish();
+}
+
+namespace {
+/*
+ * @brief Readers pin, read and let go of snapshots, and read the version
+ *        unpinned, while a writer publishes two exchanges in turn: odd
+ *        versions hold rate 1, even ones rate 2.
+ */
+void test_concurrent_publish() {
+    write_test_file("btc_test_shared_1.csv", "date,exchange_rate\n2020-01-01,1\n");
+    write_test_file("btc_test_shared_2.csv", "date,exchange_rate\n2020-01-01,2\n");
+    BitcoinExchange exchanges[2];
+    exchanges[0].load_data("btc_test_shared_1.csv");
+    exchanges[1].load_data("btc_test_shared_2.csv");
+    std::remove("btc_test_shared_1.csv");
+    std::remove("btc_test_shared_2.csv");
+
+    SharedExchange shared(reader_count);
+    int stop = 0;
+    int ready = 0;
+    ReaderRun runs[reader_count];
+    pthread_t threads[reader_count];
+    int started = 0;
+    for (; started < reader_count; ++started) {
+        runs[started].shared = &shared;
+        runs[started].stop = &stop;
+        runs[started].ready = &ready;
+        runs[started].date = toolbox::Date(toolbox::GREGORIAN, "2020-06-01",
+            "%Y-%m-%d");
+        runs[started].reads = 0;
+        runs[started].torn_reads = 0;
+        runs[started].backward_reads = 0;
+        if (::pthread_create(&threads[started], NULL, read_until_stopped,
+                &runs[started]) != 0) {
+            break;
+        }
+    }
+    check(started == reader_count, "SharedExchange: reader threads start");
+    while (__atomic_load_n(&ready, __ATOMIC_SEQ_CST) < started) {
+        ::sched_yield();
+    }
+    bool versions_in_order = true;
+    for (uint64_t i = 1; i <= publish_count; ++i) {
+        versions_in_order = shared.publish(exchanges[(i - 1) % 2]) == i
+            && versions_in_order;
+    }
+    __atomic_store_n(&stop, 1, __ATOMIC_SEQ_CST);
+    std::size_t reads = 0;
+    std::size_t torn_reads = 0;
+    std::size_t backward_reads = 0;
+    for (int i = 0; i < started; ++i) {
+        ::pthread_join(threads[i], NULL);
+        reads += runs[i].reads;
+        torn_reads += runs[i].torn_reads;
+        backward_reads += runs[i].backward_reads;
+    }
+    check(versions_in_order, "SharedExchange: publish numbers versions");
+    check(shared.version() == publish_count,
+        "SharedExchange: version of the last publish");
+    check(reads > 0, "SharedExchange: readers read");
+    check(torn_reads == 0, "SharedExchange: pinned data matches version");
+    check(backward_reads == 0, "SharedExchange: versions never go back");
+    check(shared.reclaim() == 0,
+        "SharedExchange: everything reclaimed once readers are gone");
+
+    SharedExchange small(1);
+    SharedExchange::Reader only(small);
+    bool thrown = false;
+    try {
+        SharedExchange::Reader extra(small);
+    } catch (const std::exception &) {
+        thrown = true;
+    }
+    check(thrown, "SharedExchange: no reader past max_readers");
+}
+
+void *read_until_stopped(void *arg) {
+    ReaderRun &run = *static_cast<ReaderRun *>(arg);
+    SharedExchange::Reader reader(*run.shared);
+    uint64_t last_current = 0;
+    uint64_t last_pinned = 0;
+    while (__atomic_load_n(run.stop, __ATOMIC_SEQ_CST) == 0) {
+        // Unpinned: must not touch a snapshot the writer may delete.
+        uint64_t current = 0;
+        for (int i = 0; i < 64; ++i) {
+            current = reader.version();
+            if (current < last_current) {
+                ++run.backward_reads;
+            }
+            last_current = current;
+        }
+        SharedExchange::ReadGuard guard(reader);
+        const uint64_t version = reader.version();
+        if (version < last_pinned || version < current) {
+            ++run.backward_reads;
+        }
+        last_pinned = version;
+        if (version == 0) {
+            if (!guard->empty()) {
+                ++run.torn_reads;
+            }
+        } else if (guard->get_exchange_rate(run.date)
+            != static_cast<double>(2 - version % 2)) {
+            ++run.torn_reads;
+        }
+        if (run.reads++ == 0) {
+            __atomic_add_fetch(run.ready, 1, __ATOMIC_SEQ_CST);
+        }
+    }
+    return NULL;
+}
+}  // namespace
@@ -0,0 +1,134 @@
+#include <toolbox/MappedFile.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace toolbox {
+
+MappedFile::MappedFile()
+    : _data(NULL), _size(0), _is_open(false), _is_mapped(false), _buffer() {
+}
+
+MappedFile::MappedFile(const std::string& filename)
+    : _data(NULL), _size(0), _is_open(false), _is_mapped(false), _buffer() {
+    open(filename);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+/*
+ * @brief Opens filename and exposes its whole contents through data().
+ * @return false if the file cannot be opened or read.
+ * @note The mapping is private and read-only; the file may be changed by
+ *       other processes, but callers must not rely on seeing those changes.
+ */
+bool MappedFile::open(const std::string& filename) {
+    close();
+    #ifndef _WIN32
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            const std::size_t length = static_cast<std::size_t>(st.st_size);
+            void* addr = ::mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                ::close(fd);
+                #ifdef MADV_SEQUENTIAL
+                    ::madvise(addr, length, MADV_SEQUENTIAL);
+                #endif
+                _data = static_cast<const char*>(addr);
+                _size = length;
+                _is_mapped = true;
+                _is_open = true;
+                return true;
+            }
+        }
+        ::close(fd);
+    #endif
+    return read_into_buffer(filename);
+}
+
+void MappedFile::close() {
+    #ifndef _WIN32
+        if (_is_mapped) {
+            ::munmap(const_cast<char*>(_data), _size);
+        }
+    #endif
+    std::vector<char>().swap(_buffer);
+    _data = NULL;
+    _size = 0;
+    _is_open = false;
+    _is_mapped = false;
+}
+
+bool MappedFile::is_open() const {
+    return _is_open;
+}
+
+const char* MappedFile::data() const {
+    return _data;
+}
+
+std::size_t MappedFile::size() const {
+    return _size;
+}
+
+bool MappedFile::read_into_buffer(const std::string& filename) {
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<char> buffer;
+    char chunk[65536];
+    while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + file.gcount());
+    }
+    if (file.bad()) {
+        return false;
+    }
+    _buffer.swap(buffer);
+    _data = _buffer.empty() ? NULL : &_buffer[0];
+    _size = _buffer.size();
+    _is_open = true;
+    return true;
+}
+
+/*
+ * @brief Splits the next line off [cursor, end) the way std::getline would,
+ *        for scanning the contents of a MappedFile in place.
+ * @param line_begin, line_end Receive the line without its '\n'.
+ * @return false once cursor has reached end.
+ */
+bool next_line(const char*& cursor, const char* end,
+    const char*& line_begin, const char*& line_end) {
+    if (cursor == end) {
+        return false;
+    }
+    line_begin = cursor;
+    const char* newline = static_cast<const char*>(
+        std::memchr(cursor, '\n', end - cursor));
+    if (newline == NULL) {
+        line_end = end;
+        cursor = end;
+    } else {
+        line_end = newline;
+        cursor = newline + 1;
+    }
+    return true;
+}
+
+}  // namespace toolbox
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace toolbox {
+
+// Read-only view of a whole file.
+// Regular files are memory-mapped so that callers can scan the contents in
+// place; anything that cannot be mapped (pipes, empty files, platforms
+// without mmap) is read into an internal buffer instead.
+class MappedFile {
+ public:
+    MappedFile();
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    bool open(const std::string& filename);
+    void close();
+
+    bool is_open() const;
+    const char* data() const;
+    std::size_t size() const;
+
+ private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    bool read_into_buffer(const std::string& filename);
+
+    const char* _data;
+    std::size_t _size;
+    bool _is_open;
+    bool _is_mapped;
+    std::vector<char> _buffer;
+};
+
+bool next_line(const char*& cursor, const char* end,
+    const char*& line_begin, const char*& line_end);
+
+}  // namespace toolbox
@@ -0,0 +1,75 @@
+#include <toolbox/OutputBuffer.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+namespace toolbox {
+
+const std::size_t OutputBuffer::DEFAULT_CAPACITY;
+
+OutputBuffer::OutputBuffer(std::ostream& os, std::size_t capacity)
+    : _os(os), _buffer(capacity ? capacity : 1), _size(0),
+    _line_buffered(false) {
+}
+
+OutputBuffer::~OutputBuffer() {
+    flush();
+}
+
+/*
+ * @brief Appends size bytes of data.
+ * @note Data larger than the whole buffer goes to the stream directly once
+ *       the pending bytes have been written, so the order is preserved.
+ */
+void OutputBuffer::append(const char* data, std::size_t size) {
+    if (size > _buffer.size() - _size) {
+        flush();
+        if (size >= _buffer.size()) {
+            _os.write(data, static_cast<std::streamsize>(size));
+            return;
+        }
+    }
+    std::memcpy(&_buffer[_size], data, size);
+    _size += size;
+}
+
+void OutputBuffer::append(char c) {
+    if (_size == _buffer.size()) {
+        flush();
+    }
+    _buffer[_size++] = c;
+}
+
+// Appends '\n'; in line-buffered mode this is also a flush point.
+void OutputBuffer::end_line() {
+    append('\n');
+    if (_line_buffered) {
+        flush();
+    }
+}
+
+// Writes the pending bytes to the stream and flushes the stream itself.
+void OutputBuffer::flush() {
+    if (_size != 0) {
+        _os.write(&_buffer[0], static_cast<std::streamsize>(_size));
+        _size = 0;
+    }
+    _os.flush();
+}
+
+// Line-buffered mode flushes at every end_line(), for interactive output.
+void OutputBuffer::set_line_buffered(bool line_buffered) {
+    _line_buffered = line_buffered;
+}
+
+bool OutputBuffer::is_line_buffered() const {
+    return _line_buffered;
+}
+
+bool OutputBuffer::empty() const {
+    return _size == 0;
+}
+
+}  // namespace toolbox
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace toolbox {
+
+// Large user-space buffer in front of an std::ostream.
+// Bytes are collected here and handed to the stream in big blocks, either
+// when the buffer is full or at an explicit flush point (flush(), the end of
+// a line in line-buffered mode, destruction), instead of once per line.
+class OutputBuffer {
+ public:
+    static const std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit OutputBuffer(std::ostream& os,
+        std::size_t capacity = DEFAULT_CAPACITY);
+    ~OutputBuffer();
+
+    void append(const char* data, std::size_t size);
+    void append(char c);
+    void end_line();
+    void flush();
+
+    void set_line_buffered(bool line_buffered);
+    bool is_line_buffered() const;
+    bool empty() const;
+
+ private:
+    OutputBuffer(const OutputBuffer&);
+    OutputBuffer& operator=(const OutputBuffer&);
+
+    std::ostream& _os;
+    std::vector<char> _buffer;
+    std::size_t _size;
+    bool _line_buffered;
+};
+
+}  // namespace toolbox
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+
+namespace toolbox {
+
+namespace hash {
+
+/**
+* @brief 64-bit FNV-1a offset basis (the initial value of a hash).
+*/
+inline uint64_t fnv1a_basis() {
+    return (static_cast<uint64_t>(0xcbf29ce4) << 32) | 0x84222325;
+}
+
+/**
+* @brief Folds size bytes of data into an FNV-1a hash.
+* @param hash The hash of the preceding bytes (fnv1a_basis() to start).
+* @note Not cryptographic; meant for detecting accidental changes.
+* @note [complexity]: O(size)
+*/
+inline uint64_t fnv1a(const char *data, std::size_t size,
+        uint64_t hash = fnv1a_basis()) {
+    const uint64_t prime = (static_cast<uint64_t>(0x00000100) << 32)
+        | 0x000001b3;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= prime;
+    }
+    return hash;
+}
+
+}  // namespace hash
+
+}  // namespace toolbox
@@ -1,8 +1,35 @@
+#include <stdint.h>
+
+#include <cfloat>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include <toolbox/string.hpp>
 
+namespace {
+bool is_space(char c);
+bool is_digit(char c);
+double strtod_range(const char *s, std::size_t size);
+
+struct DiyFp {
+    uint64_t f;
+    int e;
+};
+
+bool shortest_digits(double value, char *digits, int &length,
+    int &decimal_exponent);
+std::size_t round_digits(char *digits, int length, int precision,
+    int &decimal_exponent, bool &ambiguous);
+std::size_t layout_general(bool negative, const char *digits, int length,
+    int decimal_exponent, int precision, char *buffer);
+std::size_t format_with_printf(double value, char *buffer, int precision);
+}  // namespace
+
 namespace toolbox {
 
 std::string to_string(int value) {
@@ -12,23 +39,620 @@ std::string to_string(int value) {
 }
 
 int stoi(const std::string &s) {
-    std::stringstream ss(s);
     int num;
-    ss >> num;
-    if (ss.fail() || !ss.eof()) {
+    if (!parse_int(s.data(), s.size(), num)) {
         throw std::invalid_argument("Invalid integer: '" + s + "'");
     }
     return num;
 }
 
+/*
+ * @brief Parses the whole range [s, s + size) as a decimal int, without
+ *        allocating or throwing.
+ * @return false if the range is not an int; value is then unchanged.
+ * @note Accepts exactly what `std::istringstream >> int` accepts when it
+ *       must consume the whole input: optional leading white space, an
+ *       optional sign and at least one digit. Values out of the range of
+ *       int are rejected.
+ */
+bool parse_int(const char *s, std::size_t size, int &value) {
+    const char *p = s;
+    const char *const end = s + size;
+    while (p != end && is_space(*p)) {
+        ++p;
+    }
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (p == end) {
+        return false;
+    }
+    // The magnitude of INT_MIN is one more than INT_MAX.
+    const unsigned long limit = negative ? 2147483648UL : 2147483647UL;
+    unsigned long magnitude = 0;
+    for (; p != end; ++p) {
+        if (!is_digit(*p)) {
+            return false;
+        }
+        magnitude = magnitude * 10 + static_cast<unsigned long>(*p - '0');
+        if (magnitude > limit) {
+            return false;
+        }
+    }
+    value = negative ? -static_cast<int>(magnitude - 1) - 1
+        : static_cast<int>(magnitude);
+    return true;
+}
+
 double stod(const std::string &s) {
-    std::stringstream ss(s);
     double num;
-    ss >> num;
-    if (ss.fail() || !ss.eof()) {
+    if (!parse_double(s.data(), s.size(), num)) {
         throw std::invalid_argument("Invalid double: '" + s + "'");
     }
     return num;
 }
 
+/*
+ * @brief Parses the whole range [s, s + size) as a decimal floating point
+ *        number, without allocating.
+ * @return false if the range is not a number; value is then unchanged.
+ * @note Accepts exactly what `std::istringstream >> double` accepts when it
+ *       must consume the whole input: optional leading white space, an
+ *       optional sign, digits with an optional '.', and an optional exponent
+ *       ("e"/"E", optional sign, digits). No hexadecimal, "inf" or "nan".
+ *       Results that overflow are rejected, results that underflow are not.
+ * @note Numbers with at most 19 significant digits whose value and power of
+ *       ten are exactly representable (the common "0.3", "47115.93") are
+ *       computed with a single correctly rounded multiplication or division;
+ *       anything else is handed to strtod.
+ */
+bool parse_double(const char *s, std::size_t size, double &value) {
+    const char *p = s;
+    const char *const end = s + size;
+    while (p != end && is_space(*p)) {
+        ++p;
+    }
+    const char *const number = p;
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    bool too_many_digits = false;
+    int exponent = 0;  // decimal exponent of the last mantissa digit
+    bool has_digits = false;
+    for (; p != end && is_digit(*p); ++p) {
+        has_digits = true;
+        if (mantissa == 0 && *p == '0') {
+            continue;
+        }
+        if (significant_digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            ++significant_digits;
+        } else {
+            too_many_digits = true;
+        }
+    }
+    if (p != end && *p == '.') {
+        for (++p; p != end && is_digit(*p); ++p) {
+            has_digits = true;
+            if (mantissa == 0 && *p == '0') {
+                --exponent;
+                continue;
+            }
+            if (significant_digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                ++significant_digits;
+                --exponent;
+            } else {
+                too_many_digits = true;
+            }
+        }
+    }
+    if (!has_digits) {
+        return false;
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negative_exponent = false;
+        if (p != end && (*p == '+' || *p == '-')) {
+            negative_exponent = (*p == '-');
+            ++p;
+        }
+        if (p == end || !is_digit(*p)) {
+            return false;
+        }
+        int exp_value = 0;
+        for (; p != end && is_digit(*p); ++p) {
+            if (exp_value < 100000) {
+                exp_value = exp_value * 10 + (*p - '0');
+            }
+        }
+        exponent += negative_exponent ? -exp_value : exp_value;
+    }
+    if (p != end) {
+        return false;
+    }
+
+    if (!too_many_digits && mantissa == 0) {
+        value = negative ? -0.0 : 0.0;
+        return true;
+    }
+#if defined(__FLT_EVAL_METHOD__) && __FLT_EVAL_METHOD__ == 0
+    // Clinger's fast path: both operands are exact doubles, so the one
+    // IEEE operation rounds correctly.
+    static const double powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const uint64_t max_exact = static_cast<uint64_t>(1) << 53;
+    if (!too_many_digits && mantissa <= max_exact
+        && exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        if (exponent < 0) {
+            result /= powers_of_ten[-exponent];
+        } else {
+            result *= powers_of_ten[exponent];
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+#endif
+
+    const double result = strtod_range(number, end - number);
+    if (result > DBL_MAX || result < -DBL_MAX) {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+/*
+ * @brief Writes the shortest decimal text that reads back as value
+ *        (toolbox::stod / strtod give the same double), '\0'-terminated.
+ * @param buffer At least DOUBLE_BUFFER_SIZE bytes.
+ * @return The length of the text.
+ * @note The layout is the one "%.17g" would use for the same value:
+ *       "0.3", "47115.93", "1e+21", "-2.5e-07". "inf" and "nan" are
+ *       written as printf writes them.
+ * @note The digits come from Grisu2 (Loitsch, "Printing Floating-Point
+ *       Numbers Quickly and Accurately with Integers", 2010): always a
+ *       round trip, and the shortest one for all but a tiny fraction of
+ *       values, where it may be one digit longer.
+ */
+std::size_t format_double(double value, char *buffer) {
+    char digits[20];
+    int length;
+    int decimal_exponent;
+    if (!shortest_digits(value, digits, length, decimal_exponent)) {
+        return format_with_printf(value, buffer, 17);
+    }
+    return layout_general(value < 0.0 || (value == 0.0 && 1.0 / value < 0.0),
+        digits, length, decimal_exponent, 17, buffer);
+}
+
+/*
+ * @brief Writes value as printf("%.*g", precision, value) would, which is
+ *        also what `std::ostream << value` writes with the default flags
+ *        (precision 6).
+ * @param buffer At least DOUBLE_BUFFER_SIZE bytes.
+ * @param precision Significant digits, clamped to [1, 17].
+ * @return The length of the text ('\0'-terminated).
+ * @note Rounding the shortest digits to precision is exact unless they sit
+ *       right next to a rounding midpoint; those rare values, precisions
+ *       above 7, subnormal values (whose ulp is too coarse for that) and
+ *       non-finite values are handed to sprintf.
+ */
+std::size_t format_double(double value, char *buffer, int precision) {
+    if (precision < 1) {
+        precision = 1;
+    } else if (precision > 17) {
+        precision = 17;
+    }
+    char digits[20];
+    int length;
+    int decimal_exponent;
+    const double magnitude = value < 0.0 ? -value : value;
+    if (precision > 7 || (magnitude < DBL_MIN && magnitude != 0.0)
+        || !shortest_digits(value, digits, length, decimal_exponent)) {
+        return format_with_printf(value, buffer, precision);
+    }
+    bool ambiguous = false;
+    length = static_cast<int>(round_digits(digits, length, precision,
+        decimal_exponent, ambiguous));
+    if (ambiguous) {
+        return format_with_printf(value, buffer, precision);
+    }
+    return layout_general(value < 0.0 || (value == 0.0 && 1.0 / value < 0.0),
+        digits, length, decimal_exponent, precision, buffer);
+}
+
 }  // namespace toolbox
+
+namespace {
+// The characters std::isspace accepts in the "C" locale.
+bool is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// strtod on a range that has already been validated by parse_double.
+double strtod_range(const char *s, std::size_t size) {
+    char buffer[128];
+    if (size < sizeof(buffer)) {
+        std::memcpy(buffer, s, size);
+        buffer[size] = '\0';
+        return std::strtod(buffer, NULL);
+    }
+    const std::string copy(s, size);
+    return std::strtod(copy.c_str(), NULL);
+}
+}  // namespace
+
+namespace {
+// Normalized 64-bit approximations of 10^k (f * 2^e), k = -348, -340, ..,
+// 340, rounded to nearest. Stored as two 32-bit halves to stay within C++98.
+struct CachedPower {
+    uint32_t f_hi;
+    uint32_t f_lo;
+    int e;
+    int k;
+};
+
+const CachedPower cached_powers[] = {
+    {0xfa8fd5a0, 0x081c0288, -1220, -348},
+    {0xbaaee17f, 0xa23ebf76, -1193, -340},
+    {0x8b16fb20, 0x3055ac76, -1166, -332},
+    {0xcf42894a, 0x5dce35ea, -1140, -324},
+    {0x9a6bb0aa, 0x55653b2d, -1113, -316},
+    {0xe61acf03, 0x3d1a45df, -1087, -308},
+    {0xab70fe17, 0xc79ac6ca, -1060, -300},
+    {0xff77b1fc, 0xbebcdc4f, -1034, -292},
+    {0xbe5691ef, 0x416bd60c, -1007, -284},
+    {0x8dd01fad, 0x907ffc3c, -980, -276},
+    {0xd3515c28, 0x31559a83, -954, -268},
+    {0x9d71ac8f, 0xada6c9b5, -927, -260},
+    {0xea9c2277, 0x23ee8bcb, -901, -252},
+    {0xaecc4991, 0x4078536d, -874, -244},
+    {0x823c1279, 0x5db6ce57, -847, -236},
+    {0xc2109436, 0x4dfb5637, -821, -228},
+    {0x9096ea6f, 0x3848984f, -794, -220},
+    {0xd77485cb, 0x25823ac7, -768, -212},
+    {0xa086cfcd, 0x97bf97f4, -741, -204},
+    {0xef340a98, 0x172aace5, -715, -196},
+    {0xb23867fb, 0x2a35b28e, -688, -188},
+    {0x84c8d4df, 0xd2c63f3b, -661, -180},
+    {0xc5dd4427, 0x1ad3cdba, -635, -172},
+    {0x936b9fce, 0xbb25c996, -608, -164},
+    {0xdbac6c24, 0x7d62a584, -582, -156},
+    {0xa3ab6658, 0x0d5fdaf6, -555, -148},
+    {0xf3e2f893, 0xdec3f126, -529, -140},
+    {0xb5b5ada8, 0xaaff80b8, -502, -132},
+    {0x87625f05, 0x6c7c4a8b, -475, -124},
+    {0xc9bcff60, 0x34c13053, -449, -116},
+    {0x964e858c, 0x91ba2655, -422, -108},
+    {0xdff97724, 0x70297ebd, -396, -100},
+    {0xa6dfbd9f, 0xb8e5b88f, -369, -92},
+    {0xf8a95fcf, 0x88747d94, -343, -84},
+    {0xb9447093, 0x8fa89bcf, -316, -76},
+    {0x8a08f0f8, 0xbf0f156b, -289, -68},
+    {0xcdb02555, 0x653131b6, -263, -60},
+    {0x993fe2c6, 0xd07b7fac, -236, -52},
+    {0xe45c10c4, 0x2a2b3b06, -210, -44},
+    {0xaa242499, 0x697392d3, -183, -36},
+    {0xfd87b5f2, 0x8300ca0e, -157, -28},
+    {0xbce50864, 0x92111aeb, -130, -20},
+    {0x8cbccc09, 0x6f5088cc, -103, -12},
+    {0xd1b71758, 0xe219652c, -77, -4},
+    {0x9c400000, 0x00000000, -50, 4},
+    {0xe8d4a510, 0x00000000, -24, 12},
+    {0xad78ebc5, 0xac620000, 3, 20},
+    {0x813f3978, 0xf8940984, 30, 28},
+    {0xc097ce7b, 0xc90715b3, 56, 36},
+    {0x8f7e32ce, 0x7bea5c70, 83, 44},
+    {0xd5d238a4, 0xabe98068, 109, 52},
+    {0x9f4f2726, 0x179a2245, 136, 60},
+    {0xed63a231, 0xd4c4fb27, 162, 68},
+    {0xb0de6538, 0x8cc8ada8, 189, 76},
+    {0x83c7088e, 0x1aab65db, 216, 84},
+    {0xc45d1df9, 0x42711d9a, 242, 92},
+    {0x924d692c, 0xa61be758, 269, 100},
+    {0xda01ee64, 0x1a708dea, 295, 108},
+    {0xa26da399, 0x9aef774a, 322, 116},
+    {0xf209787b, 0xb47d6b85, 348, 124},
+    {0xb454e4a1, 0x79dd1877, 375, 132},
+    {0x865b8692, 0x5b9bc5c2, 402, 140},
+    {0xc83553c5, 0xc8965d3d, 428, 148},
+    {0x952ab45c, 0xfa97a0b3, 455, 156},
+    {0xde469fbd, 0x99a05fe3, 481, 164},
+    {0xa59bc234, 0xdb398c25, 508, 172},
+    {0xf6c69a72, 0xa3989f5c, 534, 180},
+    {0xb7dcbf53, 0x54e9bece, 561, 188},
+    {0x88fcf317, 0xf22241e2, 588, 196},
+    {0xcc20ce9b, 0xd35c78a5, 614, 204},
+    {0x98165af3, 0x7b2153df, 641, 212},
+    {0xe2a0b5dc, 0x971f303a, 667, 220},
+    {0xa8d9d153, 0x5ce3b396, 694, 228},
+    {0xfb9b7cd9, 0xa4a7443c, 720, 236},
+    {0xbb764c4c, 0xa7a44410, 747, 244},
+    {0x8bab8eef, 0xb6409c1a, 774, 252},
+    {0xd01fef10, 0xa657842c, 800, 260},
+    {0x9b10a4e5, 0xe9913129, 827, 268},
+    {0xe7109bfb, 0xa19c0c9d, 853, 276},
+    {0xac2820d9, 0x623bf429, 880, 284},
+    {0x80444b5e, 0x7aa7cf85, 907, 292},
+    {0xbf21e440, 0x03acdd2d, 933, 300},
+    {0x8e679c2f, 0x5e44ff8f, 960, 308},
+    {0xd433179d, 0x9c8cb841, 986, 316},
+    {0x9e19db92, 0xb4e31ba9, 1013, 324},
+    {0xeb96bf6e, 0xbadf77d9, 1039, 332},
+    {0xaf87023b, 0x9bf0ee6b, 1066, 340},
+};
+
+// Target range [-60, -32] of the scaled binary exponent.
+const int grisu_min_exponent = -60;
+
+DiyFp make_diyfp(uint64_t f, int e) {
+    DiyFp x;
+    x.f = f;
+    x.e = e;
+    return x;
+}
+
+// The upper 64 bits of the 128-bit product, rounded.
+DiyFp multiply(const DiyFp &x, const DiyFp &y) {
+    const uint64_t mask = 0xffffffffu;
+    const uint64_t a = x.f >> 32;
+    const uint64_t b = x.f & mask;
+    const uint64_t c = y.f >> 32;
+    const uint64_t d = y.f & mask;
+    const uint64_t ac = a * c;
+    const uint64_t bc = b * c;
+    const uint64_t ad = a * d;
+    const uint64_t bd = b * d;
+    uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask);
+    middle += static_cast<uint64_t>(1) << 31;
+    return make_diyfp(ac + (ad >> 32) + (bc >> 32) + (middle >> 32),
+        x.e + y.e + 64);
+}
+
+DiyFp normalize(DiyFp x) {
+    while ((x.f >> 63) == 0) {
+        x.f <<= 1;
+        --x.e;
+    }
+    return x;
+}
+
+// Number of decimal digits of n (n < 10^10); pow10 receives 10^(digits-1).
+int count_digits(uint32_t n, uint32_t &pow10) {
+    static const uint32_t powers[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+        1000000000
+    };
+    int digits = 1;
+    while (digits < 10 && n >= powers[digits]) {
+        ++digits;
+    }
+    pow10 = powers[digits - 1];
+    return digits;
+}
+
+// Moves the last digit down while that brings the digits closer to w.
+void round_weed(char *digits, int length, uint64_t dist, uint64_t delta,
+        uint64_t rest, uint64_t ten_k) {
+    while (rest < dist && delta - rest >= ten_k
+        && (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+        --digits[length - 1];
+        rest += ten_k;
+    }
+}
+
+/*
+ * @brief Grisu2 digit generation for a finite, nonzero value.
+ * @note value = digits * 10^decimal_exponent, with digits[0] != '0'.
+ */
+void grisu2(double value, char *digits, int &length, int &decimal_exponent) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint64_t hidden_bit = static_cast<uint64_t>(1) << 52;
+    const uint64_t fraction = bits & (hidden_bit - 1);
+    const int biased_exponent = static_cast<int>((bits >> 52) & 0x7ff);
+    const DiyFp v = (biased_exponent == 0)
+        ? make_diyfp(fraction, 1 - 1075)
+        : make_diyfp(fraction + hidden_bit, biased_exponent - 1075);
+
+    // Boundaries of the rounding interval of v, with the same exponent.
+    const bool lower_is_closer = fraction == 0 && biased_exponent > 1;
+    const DiyFp m_plus = normalize(make_diyfp(2 * v.f + 1, v.e - 1));
+    DiyFp m_minus = lower_is_closer
+        ? make_diyfp(4 * v.f - 1, v.e - 2)
+        : make_diyfp(2 * v.f - 1, v.e - 1);
+    m_minus.f <<= m_minus.e - m_plus.e;
+    m_minus.e = m_plus.e;
+    const DiyFp w = normalize(v);
+
+    // Pick c = 10^-k so that the scaled exponent lands in [alpha, gamma].
+    const int f = grisu_min_exponent - m_plus.e - 1;
+    const int k = (f * 78913) / (1 << 18) + (f > 0);
+    const int index = (348 + k + 7) / 8;
+    const CachedPower &cached = cached_powers[index];
+    const DiyFp c = make_diyfp(
+        (static_cast<uint64_t>(cached.f_hi) << 32) | cached.f_lo, cached.e);
+
+    const DiyFp w_scaled = multiply(w, c);
+    DiyFp low = multiply(m_minus, c);
+    DiyFp high = multiply(m_plus, c);
+    ++low.f;
+    --high.f;
+    decimal_exponent = -cached.k;
+
+    uint64_t delta = high.f - low.f;
+    uint64_t dist = high.f - w_scaled.f;
+    const int shift = -high.e;
+    const uint64_t one = static_cast<uint64_t>(1) << shift;
+    uint32_t p1 = static_cast<uint32_t>(high.f >> shift);
+    uint64_t p2 = high.f & (one - 1);
+
+    length = 0;
+    uint32_t pow10;
+    int n = count_digits(p1, pow10);
+    while (n > 0) {
+        digits[length++] = static_cast<char>('0' + p1 / pow10);
+        p1 %= pow10;
+        --n;
+        const uint64_t rest = (static_cast<uint64_t>(p1) << shift) + p2;
+        if (rest <= delta) {
+            decimal_exponent += n;
+            round_weed(digits, length, dist, delta, rest,
+                static_cast<uint64_t>(pow10) << shift);
+            return;
+        }
+        pow10 /= 10;
+    }
+    int m = 0;
+    for (;;) {
+        p2 *= 10;
+        digits[length++] = static_cast<char>('0' + (p2 >> shift));
+        p2 &= one - 1;
+        ++m;
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta) {
+            break;
+        }
+    }
+    decimal_exponent -= m;
+    round_weed(digits, length, dist, delta, p2, one);
+}
+
+/*
+ * @brief Shortest digits of value, with decimal_exponent turned into the
+ *        exponent of the first digit (value = d.ddd * 10^decimal_exponent).
+ * @return false for infinities and NaN.
+ */
+bool shortest_digits(double value, char *digits, int &length,
+        int &decimal_exponent) {
+    if (value != value || value > DBL_MAX || value < -DBL_MAX) {
+        return false;
+    }
+    if (value == 0.0) {
+        digits[0] = '0';
+        length = 1;
+        decimal_exponent = 0;
+        return true;
+    }
+    grisu2(value < 0.0 ? -value : value, digits, length, decimal_exponent);
+    while (length > 1 && digits[length - 1] == '0') {
+        --length;
+        ++decimal_exponent;
+    }
+    decimal_exponent += length - 1;
+    return true;
+}
+
+/*
+ * @brief Rounds digits (exact to within half an ulp of the value) to
+ *        precision significant digits, half away from zero like printf on
+ *        an exact value, and drops trailing zeros.
+ * @param ambiguous Set when the dropped digits are too close to a midpoint
+ *        for the ulp of uncertainty to be ruled out.
+ * @return The new length.
+ */
+std::size_t round_digits(char *digits, int length, int precision,
+        int &decimal_exponent, bool &ambiguous) {
+    if (length > precision) {
+        // Up to precision 7 the value is within 1e-8 of a unit in the last
+        // kept place of the digits, so 8 dropped digits decide the rounding.
+        char tail[8];
+        for (int i = 0; i < 8; ++i) {
+            tail[i] = (precision + i < length) ? digits[precision + i] : '0';
+        }
+        if (std::memcmp(tail, "50000000", 8) == 0
+            || std::memcmp(tail, "49999999", 8) == 0) {
+            ambiguous = true;
+            return length;
+        }
+        const bool round_up = tail[0] >= '5';
+        length = precision;
+        if (round_up) {
+            int i = length - 1;
+            while (i >= 0 && digits[i] == '9') {
+                digits[i--] = '0';
+            }
+            if (i < 0) {
+                digits[0] = '1';
+                length = 1;
+                ++decimal_exponent;
+            } else {
+                ++digits[i];
+            }
+        }
+    }
+    while (length > 1 && digits[length - 1] == '0') {
+        --length;
+    }
+    return length;
+}
+
+/*
+ * @brief The "%g" layout without '#': fixed notation when
+ *        -4 <= exponent < precision, otherwise d.ddde+XX.
+ */
+std::size_t layout_general(bool negative, const char *digits, int length,
+        int decimal_exponent, int precision, char *buffer) {
+    char *out = buffer;
+    if (negative) {
+        *out++ = '-';
+    }
+    if (decimal_exponent < -4 || decimal_exponent >= precision) {
+        *out++ = digits[0];
+        if (length > 1) {
+            *out++ = '.';
+            std::memcpy(out, digits + 1, length - 1);
+            out += length - 1;
+        }
+        *out++ = 'e';
+        int exponent = decimal_exponent;
+        *out++ = exponent < 0 ? '-' : '+';
+        exponent = exponent < 0 ? -exponent : exponent;
+        if (exponent >= 100) {
+            *out++ = static_cast<char>('0' + exponent / 100);
+        }
+        *out++ = static_cast<char>('0' + exponent / 10 % 10);
+        *out++ = static_cast<char>('0' + exponent % 10);
+    } else if (decimal_exponent < 0) {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = -1; i > decimal_exponent; --i) {
+            *out++ = '0';
+        }
+        std::memcpy(out, digits, length);
+        out += length;
+    } else {
+        const int integer_digits = decimal_exponent + 1;
+        for (int i = 0; i < integer_digits; ++i) {
+            *out++ = (i < length) ? digits[i] : '0';
+        }
+        if (length > integer_digits) {
+            *out++ = '.';
+            std::memcpy(out, digits + integer_digits, length - integer_digits);
+            out += length - integer_digits;
+        }
+    }
+    *out = '\0';
+    return static_cast<std::size_t>(out - buffer);
+}
+
+std::size_t format_with_printf(double value, char *buffer, int precision) {
+    const int size = std::sprintf(buffer, "%.*g", precision, value);
+    return size < 0 ? 0 : static_cast<std::size_t>(size);
+}
+}  // namespace
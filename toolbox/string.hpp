@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <sstream>
 
@@ -7,6 +8,14 @@ namespace toolbox {
 
 std::string to_string(int value);
 int stoi(const std::string &s);
+bool parse_int(const char *s, std::size_t size, int &value);
 double stod(const std::string &s);
+bool parse_double(const char *s, std::size_t size, double &value);
+
+// Room for any output of format_double, terminating '\0' included.
+const std::size_t DOUBLE_BUFFER_SIZE = 32;
+
+std::size_t format_double(double value, char *buffer);
+std::size_t format_double(double value, char *buffer, int precision);
 
 }  // namespace toolbox